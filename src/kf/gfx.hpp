@@ -5,7 +5,33 @@
 /// KiraFlux Graphics
 namespace kf::gfx {}
 
+#include <kf/gfx/AnimatedSprite.hpp>
+#include <kf/gfx/Animation.hpp>
+#include <kf/gfx/Barcode.hpp>
+#include <kf/gfx/BarGraph.hpp>
+#include <kf/gfx/Bezier.hpp>
 #include <kf/gfx/BitMap.hpp>
 #include <kf/gfx/Canvas.hpp>
+#include <kf/gfx/Chart.hpp>
+#include <kf/gfx/Collision.hpp>
+#include <kf/gfx/Compositor.hpp>
+#include <kf/gfx/Dither.hpp>
+#include <kf/gfx/DrawInterpreter.hpp>
+#include <kf/gfx/DrawLog.hpp>
+#include <kf/gfx/DrawPlayer.hpp>
+#include <kf/gfx/DrawRecorder.hpp>
 #include <kf/gfx/Font.hpp>
+#include <kf/gfx/FrameDelta.hpp>
 #include <kf/gfx/FrameView.hpp>
+#include <kf/gfx/Gauge.hpp>
+#include <kf/gfx/ImageDecoder.hpp>
+#include <kf/gfx/LinePattern.hpp>
+#include <kf/gfx/Morphology.hpp>
+#include <kf/gfx/Path.hpp>
+#include <kf/gfx/ProgressBar.hpp>
+#include <kf/gfx/QrCode.hpp>
+#include <kf/gfx/Rotozoom.hpp>
+#include <kf/gfx/SegmentDisplay.hpp>
+#include <kf/gfx/SnapshotRecorder.hpp>
+#include <kf/gfx/TileMap.hpp>
+#include <kf/gfx/Trig.hpp>
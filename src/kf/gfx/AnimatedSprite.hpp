@@ -0,0 +1,263 @@
+#pragma once
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/BitMap.hpp"
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Анимированный спрайт: первый кадр и изменённые столбцы каждого следующего
+/// @details Запись перехода кадра i в кадр i + 1 (после последнего - в первый):
+/// количество столбцов (u8), затем для каждого столбца его X (u8) и pages байт XOR
+/// @details Спрайт владеет своей областью: draw() перезаписывает её,
+/// update() применяет к ней только изменённые столбцы
+struct AnimatedSprite final {
+
+    /// @brief Ошибки
+    enum class Error : u8 {
+
+        /// @brief Пустой кадр, нет кадров или ширина больше 255
+        BadSize,
+
+        /// @brief Записи переходов не соответствуют кадрам
+        Corrupted,
+    };
+
+private:
+    /// @brief Первый кадр
+    BitMapView first;
+
+    /// @brief Записи переходов
+    const u8 *deltas;
+
+    /// @brief Смещение записи перехода из показанного кадра
+    usize cursor{0};
+
+    /// @brief Накопленное время текущего кадра
+    u32 elapsed{0};
+
+    /// @brief Количество кадров
+    u8 count;
+
+    /// @brief Текущий кадр
+    u8 current{0};
+
+    /// @brief Кадр в целевой области
+    u8 shown{0};
+
+public:
+    /// @brief Длительность кадра в мс
+    u16 frame_duration_ms;
+
+    /// @brief Создать спрайт с проверкой записей переходов
+    [[nodiscard]] static Result<AnimatedSprite, Error> create(
+        /// @brief Первый кадр
+        const BitMapView &first,
+
+        /// @brief Записи переходов (см. encode)
+        const u8 *deltas,
+
+        /// @brief Размер записей
+        usize deltas_size,
+
+        /// @brief Количество кадров
+        u8 frames,
+
+        /// @brief Длительность кадра в мс
+        u16 frame_duration_ms) noexcept {
+        if (nullptr == first.buffer or first.width < 1 or first.width > 0xFF or first.height < 1 or frames < 1) {
+            return Error::BadSize;
+        }
+
+        const auto column_size = static_cast<usize>(1 + first.pages());
+        usize offset = 0;
+
+        for (u8 frame = 0; frame < frames; ++frame) {
+            if (offset >= deltas_size) { return Error::Corrupted; }
+
+            const u8 columns = deltas[offset];
+            offset += 1;
+
+            if (offset + columns * column_size > deltas_size) { return Error::Corrupted; }
+
+            for (u8 i = 0; i < columns; ++i, offset += column_size) {
+                if (deltas[offset] >= first.width) { return Error::Corrupted; }
+            }
+        }
+
+        if (offset != deltas_size) { return Error::Corrupted; }
+
+        return AnimatedSprite{first, deltas, frames, frame_duration_ms};
+    }
+
+    /// @brief Построить записи переходов для кадров одного размера
+    /// @param out Буфер записей или nullptr для расчёта размера
+    /// @returns Размер записей, 0 - кадры разного размера или не хватает места
+    static usize encode(const BitMapView *frames, u8 frames_count, u8 *out, usize capacity) noexcept {
+        if (nullptr == frames or frames_count < 1) { return 0; }
+
+        const Pixel width = frames[0].width;
+        const Pixel pages = frames[0].pages();
+        if (width < 1 or width > 0xFF) { return 0; }
+
+        // Биты последней страницы за пределами высоты не относятся к изображению
+        const auto last_mask = FrameView::createPageMask(0, static_cast<u8>((frames[0].height - 1) & 0x07));
+
+        const auto byteAt = [pages, last_mask](const BitMapView &frame, Pixel x, Pixel page) -> u8 {
+            const u8 data = frame.buffer[page * frame.width + x];
+            return page == pages - 1 ? data & last_mask : data;
+        };
+
+        usize size = 0;
+
+        for (u8 i = 0; i < frames_count; ++i) {
+            const BitMapView &from = frames[i];
+            const BitMapView &to = frames[i + 1 == frames_count ? 0 : i + 1];
+            if (to.width != width or to.height != frames[0].height) { return 0; }
+
+            const usize header = size;
+            u8 columns = 0;
+            size += 1;
+
+            for (Pixel x = 0; x < width; ++x) {
+                bool changed = false;
+                for (Pixel page = 0; page < pages and not changed; ++page) {
+                    changed = byteAt(from, x, page) != byteAt(to, x, page);
+                }
+                if (not changed) { continue; }
+
+                if (nullptr != out) {
+                    if (size + 1 + pages > capacity) { return 0; }
+
+                    out[size] = static_cast<u8>(x);
+                    for (Pixel page = 0; page < pages; ++page) {
+                        out[size + 1 + page] = byteAt(from, x, page) ^ byteAt(to, x, page);
+                    }
+                }
+
+                size += 1 + pages;
+                columns += 1;
+            }
+
+            if (nullptr != out) {
+                if (header >= capacity) { return 0; }
+                out[header] = columns;
+            }
+        }
+
+        return size;
+    }
+
+    /// @brief Количество кадров
+    [[nodiscard]] inline u8 frames() const noexcept { return count; }
+
+    /// @brief Текущий кадр
+    [[nodiscard]] inline u8 frame() const noexcept { return current; }
+
+    /// @brief Ширина спрайта
+    [[nodiscard]] inline Pixel width() const noexcept { return first.width; }
+
+    /// @brief Высота спрайта
+    [[nodiscard]] inline Pixel height() const noexcept { return first.height; }
+
+    /// @brief Целевая область отстаёт от текущего кадра
+    [[nodiscard]] inline bool pending() const noexcept { return shown != current; }
+
+    /// @brief Продвинуть время анимации
+    /// @returns Количество пройденных кадров
+    u8 tick(u32 elapsed_ms) noexcept {
+        if (count < 2 or frame_duration_ms == 0) { return 0; }
+
+        elapsed += elapsed_ms;
+        const u32 steps = elapsed / frame_duration_ms;
+        elapsed -= steps * frame_duration_ms;
+
+        current = static_cast<u8>((current + steps) % count);
+        return static_cast<u8>(steps < 0xFF ? steps : 0xFF);
+    }
+
+    /// @brief Нарисовать текущий кадр целиком
+    void draw(const FrameView &target, Pixel x, Pixel y) noexcept {
+        const Pixel pages = first.pages();
+
+        for (Pixel page = 0; page < pages; ++page) {
+            const u8 mask = pageMask(page);
+            const u8 *source = first.buffer + page * first.width;
+
+            for (Pixel column = 0; column < first.width; ++column) {
+                target.writeColumn(
+                    static_cast<Pixel>(x + column),
+                    static_cast<Pixel>(y + (page << 3)),
+                    source[column],
+                    mask);
+            }
+        }
+
+        // Первый кадр показан, остальные - через переходы
+        shown = 0;
+        cursor = 0;
+        update(target, x, y);
+    }
+
+    /// @brief Применить к области переходы от показанного кадра к текущему
+    /// @details Записываются только изменённые столбцы
+    /// @returns Количество применённых переходов
+    u8 update(const FrameView &target, Pixel x, Pixel y) noexcept {
+        const Pixel pages = first.pages();
+        u8 applied = 0;
+
+        while (shown != current) {
+            const u8 columns = deltas[cursor];
+            cursor += 1;
+
+            for (u8 i = 0; i < columns; ++i) {
+                const auto column_x = static_cast<Pixel>(x + deltas[cursor]);
+                const u8 *data = deltas + cursor + 1;
+
+                for (Pixel page = 0; page < pages; ++page) {
+                    if (data[page] == 0) { continue; }
+
+                    target.writeColumn(
+                        column_x,
+                        static_cast<Pixel>(y + (page << 3)),
+                        data[page],
+                        pageMask(page),
+                        FrameView::RasterOp::Xor);
+                }
+
+                cursor += 1 + pages;
+            }
+
+            shown += 1;
+            if (shown == count) {
+                shown = 0;
+                cursor = 0;
+            }
+
+            applied += 1;
+        }
+
+        return applied;
+    }
+
+    /// @brief Перейти к кадру без отрисовки
+    void reset(u8 frame = 0) noexcept {
+        current = static_cast<u8>(frame % count);
+        elapsed = 0;
+    }
+
+private:
+    explicit AnimatedSprite(const BitMapView &first, const u8 *deltas, u8 count, u16 frame_duration_ms) noexcept :
+        first{first}, deltas{deltas}, count{count}, frame_duration_ms{frame_duration_ms} {}
+
+    /// @brief Маска строк страницы спрайта
+    [[nodiscard]] inline u8 pageMask(Pixel page) const noexcept {
+        if (page < first.pages() - 1) { return 0xFF; }
+        return FrameView::createPageMask(0, static_cast<u8>((first.height - 1) & 0x07));
+    }
+};
+
+}// namespace kf::gfx
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/FrameDelta.hpp"
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Формат 1-битной анимации
+/// @details Заголовок: "KFAN", версия (u8), ширина (u16), высота (u16),
+/// количество кадров (u16), длительность кадра в мс (u16)
+/// @details Индекс: смещение записи кадра от начала файла (u32) на каждый кадр,
+/// старший бит смещения - признак ключевого кадра
+/// @details Запись кадра: длина (u16) и дельта frame_delta. Дельта ключевого кадра
+/// строится относительно пустого кадра, остальных - относительно предыдущего
+/// @details Числа little-endian, кадр в страничном формате дисплея
+namespace animation {
+
+/// @brief Сигнатура
+static constexpr u8 magic[4] = {'K', 'F', 'A', 'N'};
+
+/// @brief Версия формата
+static constexpr u8 version = 1;
+
+/// @brief Размер заголовка в байтах
+static constexpr usize header_size = 13;
+
+/// @brief Размер элемента индекса
+static constexpr usize index_entry_size = 4;
+
+/// @brief Признак ключевого кадра в индексе
+static constexpr u32 key_frame_flag = 0x80000000u;
+
+/// @brief Размер заголовка записи кадра
+static constexpr usize record_header_size = 2;
+
+}// namespace animation
+
+/// @brief Проигрыватель анимации из памяти
+/// @details Данные читаются по указателю: отображённый в память файл (Linux)
+/// или анимация во флеш-памяти микроконтроллера
+/// @details Кадры декодируются прямо в целевую область без промежуточного буфера.
+/// Область должна содержать предыдущий показанный кадр (дельты применяются через XOR)
+struct AnimationPlayer final {
+
+    /// @brief Ошибки
+    enum class Error : u8 {
+
+        /// @brief Неверная сигнатура или размер заголовка
+        BadHeader,
+
+        /// @brief Неподдерживаемая версия формата
+        UnsupportedVersion,
+
+        /// @brief Данные обрываются
+        Truncated,
+
+        /// @brief Повреждённая запись кадра
+        Corrupted,
+
+        /// @brief Кадр вне диапазона
+        FrameOutOfRange,
+    };
+
+    /// @brief Диапазон изменённых страниц дисплея (абсолютных) для частичной отправки
+    struct PageRange final {
+
+        /// @brief Первая изменённая страница
+        Pixel first;
+
+        /// @brief Последняя изменённая страница
+        Pixel last;
+
+        /// @brief Изменений нет
+        [[nodiscard]] inline bool empty() const noexcept { return first > last; }
+    };
+
+private:
+    /// @brief Данные анимации
+    const u8 *data;
+
+    /// @brief Размер данных
+    usize data_size;
+
+    /// @brief Показанный кадр (frames() - ничего не показано)
+    u16 current;
+
+public:
+    /// @brief Ширина кадра
+    Pixel width;
+
+    /// @brief Высота кадра
+    Pixel height;
+
+    /// @brief Количество кадров
+    u16 frames;
+
+    /// @brief Длительность кадра в мс
+    u16 frame_duration_ms;
+
+    /// @brief Проверить заголовок и индекс анимации
+    [[nodiscard]] static Result<AnimationPlayer, Error> create(const u8 *data, usize data_size) noexcept {
+        if (nullptr == data or data_size < animation::header_size) { return Error::BadHeader; }
+
+        for (usize i = 0; i < sizeof(animation::magic); ++i) {
+            if (data[i] != animation::magic[i]) { return Error::BadHeader; }
+        }
+
+        if (data[4] != animation::version) { return Error::UnsupportedVersion; }
+
+        const AnimationPlayer player{
+            data,
+            data_size,
+            static_cast<Pixel>(readU16(data + 5)),
+            static_cast<Pixel>(readU16(data + 7)),
+            readU16(data + 9),
+            readU16(data + 11)};
+
+        if (player.width < 1 or player.height < 1) { return Error::BadHeader; }
+        if (data_size < animation::header_size + player.frames * animation::index_entry_size) { return Error::Truncated; }
+
+        return player;
+    }
+
+    /// @brief Размер кадра в байтах
+    [[nodiscard]] inline usize frameSize() const noexcept { return width * ((height + 7) / 8); }
+
+    /// @brief Индекс показанного кадра
+    /// @returns frames, если ничего не показано
+    [[nodiscard]] inline u16 position() const noexcept { return current; }
+
+    /// @brief Показать следующий кадр (после последнего - первый)
+    Result<PageRange, Error> next(const FrameView &target) noexcept {
+        const auto frame = static_cast<u16>(current + 1 >= frames ? 0 : current + 1);
+        return seek(frame, target);
+    }
+
+    /// @brief Показать указанный кадр
+    /// @details Декодирует от ближайшего ключевого кадра, если кадр не следующий за текущим
+    Result<PageRange, Error> seek(u16 frame, const FrameView &target) noexcept {
+        if (frame >= frames) { return Error::FrameOutOfRange; }
+
+        // Ближайший ключевой кадр, либо продолжение от показанного
+        u16 start = frame;
+        while (start > 0 and not isKeyFrame(start)) { start -= 1; }
+
+        if (current < frames and current < frame and start <= current) {
+            start = static_cast<u16>(current + 1);
+        }
+
+        // Область анимации внутри цели
+        FrameView area = target;
+        area.width = std::min(area.width, width);
+        area.height = std::min(area.height, height);
+
+        PageRange range{height, -1};
+
+        for (u16 i = start; i <= frame; ++i) {
+            if (isKeyFrame(i)) {
+                area.fill(false);
+                range = {0, static_cast<Pixel>((height - 1) >> 3)};
+            }
+
+            const auto result = applyRecord(i, area);
+            if (not result.isOk()) {
+                current = frames;
+                return result.error().value();
+            }
+
+            const auto span = result.ok().value();
+            if (not span.empty()) {
+                range.first = std::min(range.first, static_cast<Pixel>(span.begin / width));
+                range.last = std::max(range.last, static_cast<Pixel>((span.end - 1) / width));
+            }
+
+            current = i;
+        }
+
+        if (range.empty()) { return range; }
+
+        // Страницы кадра в страницы дисплея (область может быть не выровнена по странице)
+        const auto top = static_cast<Pixel>(area.offset_y + (range.first << 3));
+        const auto bottom = static_cast<Pixel>(std::min(
+            area.offset_y + (range.last << 3) + 7,
+            area.offset_y + area.height - 1));
+
+        if (top > bottom) { return PageRange{0, -1}; }
+
+        return PageRange{static_cast<Pixel>(top >> 3), static_cast<Pixel>(bottom >> 3)};
+    }
+
+private:
+    explicit AnimationPlayer(const u8 *data, usize data_size, Pixel width, Pixel height, u16 frames, u16 frame_duration_ms) noexcept :
+        data{data},
+        data_size{data_size},
+        current{frames},
+        width{width},
+        height{height},
+        frames{frames},
+        frame_duration_ms{frame_duration_ms} {}
+
+    [[nodiscard]] static inline u16 readU16(const u8 *p) noexcept {
+        return static_cast<u16>(p[0] | (p[1] << 8));
+    }
+
+    [[nodiscard]] inline u32 indexEntry(u16 frame) const noexcept {
+        const u8 *p = data + animation::header_size + frame * animation::index_entry_size;
+        return static_cast<u32>(p[0]) |
+               (static_cast<u32>(p[1]) << 8) |
+               (static_cast<u32>(p[2]) << 16) |
+               (static_cast<u32>(p[3]) << 24);
+    }
+
+    [[nodiscard]] inline bool isKeyFrame(u16 frame) const noexcept {
+        return frame == 0 or (indexEntry(frame) & animation::key_frame_flag);
+    }
+
+    /// @brief Применить запись кадра к области
+    Result<frame_delta::Span, Error> applyRecord(u16 frame, const FrameView &target) const noexcept {
+        const usize offset = indexEntry(frame) & ~animation::key_frame_flag;
+        if (offset + animation::record_header_size > data_size) { return Error::Truncated; }
+
+        const usize record_size = readU16(data + offset);
+        const u8 *record = data + offset + animation::record_header_size;
+        if (offset + animation::record_header_size + record_size > data_size) { return Error::Truncated; }
+
+        const Pixel w = width;
+        const auto result = frame_delta::decode(
+            [record](usize i) { return record[i]; },
+            record_size,
+            frameSize(),
+            [&target, w](usize i, u8 d) {
+                const auto page = static_cast<Pixel>(i / w);
+                const auto x = static_cast<Pixel>(i - page * w);
+                target.writeColumn(x, static_cast<Pixel>(page << 3), d, 0xFF, FrameView::RasterOp::Xor);
+            });
+
+        if (not result.isOk()) { return Error::Corrupted; }
+        return result.ok().value();
+    }
+};
+
+}// namespace kf::gfx
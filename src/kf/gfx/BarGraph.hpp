@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Столбчатый индикатор (анализатор спектра)
+/// @details Для каждого столбца запоминается высота на экране. render() записывает только
+/// полосу строк между старой и новой высотой: при росте - включает, при падении - выключает.
+/// Полоса пишется побайтово по страницам, маски строк считаются один раз на столбец,
+/// поэтому стоимость кадра пропорциональна изменению, а не площади столбцов
+/// @details Метка пика удерживается peak_hold кадров над столбцом, затем опускается на peak_fall пикселей за кадр
+/// @tparam Bars Количество столбцов
+template<u8 Bars> struct BarGraph final {
+
+    /// @brief Ошибки
+    enum class Error : u8 {
+
+        /// @brief Нулевая ширина столбца, высота или максимум значения
+        BadGeometry,
+    };
+
+private:
+    /// @brief Высота столбцов для отображения
+    Pixel wanted[Bars]{};
+
+    /// @brief Высота столбцов на экране
+    Pixel shown[Bars]{};
+
+    /// @brief Высота пиков
+    Pixel peak[Bars]{};
+
+    /// @brief Высота меток пиков на экране (0 - метки нет)
+    Pixel shown_peak[Bars]{};
+
+    /// @brief Оставшиеся кадры удержания пиков
+    u8 hold[Bars]{};
+
+    /// @brief Ширина столбца
+    Pixel bar_width;
+
+    /// @brief Промежуток между столбцами
+    Pixel gap;
+
+    /// @brief Высота индикатора
+    Pixel height;
+
+    /// @brief Значение полной высоты
+    u16 max_value;
+
+    /// @brief Пикселей на единицу значения, Q16 (деление заменено умножением)
+    u32 scale;
+
+    /// @brief Значение пикселей столбца
+    bool on;
+
+    /// @brief Положение на экране
+    Pixel last_x{0}, last_y{0};
+
+    /// @brief Перерисовать всё
+    bool redraw_all{true};
+
+public:
+    /// @brief Кадров удержания пика (0 - без меток пиков)
+    u8 peak_hold{0};
+
+    /// @brief Падение пика после удержания, пикселей за кадр
+    u8 peak_fall{1};
+
+    /// @brief Создать индикатор
+    /// @param bar_width Ширина столбца
+    /// @param gap Промежуток между столбцами
+    /// @param height Высота столбцов
+    /// @param max_value Значение, соответствующее полной высоте
+    /// @param on Значение пикселей столбца
+    [[nodiscard]] static Result<BarGraph, Error> create(
+        Pixel bar_width,
+        Pixel gap,
+        Pixel height,
+        u16 max_value = 255,
+        bool on = true) noexcept {
+        if (bar_width < 1 or gap < 0 or height < 1 or max_value == 0) { return Error::BadGeometry; }
+        return BarGraph{bar_width, gap, height, max_value, on};
+    }
+
+    /// @brief Ширина индикатора в пикселях
+    [[nodiscard]] inline Pixel pixelWidth() const noexcept {
+        return static_cast<Pixel>(Bars * (bar_width + gap) - gap);
+    }
+
+    /// @brief Высота индикатора в пикселях
+    [[nodiscard]] inline Pixel pixelHeight() const noexcept { return height; }
+
+    /// @brief Установить значение столбца (ограничивается max_value)
+    void set(u8 index, u16 value) noexcept {
+        if (index >= Bars) { return; }
+        value = std::min(value, max_value);
+        wanted[index] = static_cast<Pixel>(std::min((value * scale + 0x8000) >> 16, static_cast<u32>(height)));
+    }
+
+    /// @brief Установить значения всех столбцов
+    void set(const u16 *values) noexcept {
+        for (u8 i = 0; i < Bars; ++i) { set(i, values[i]); }
+    }
+
+    /// @brief Высота столбца в пикселях
+    [[nodiscard]] inline Pixel level(u8 index) const noexcept { return wanted[index]; }
+
+    /// @brief Перерисовать всё при следующем render()
+    void invalidate() noexcept { redraw_all = true; }
+
+    /// @brief Обновить индикатор на экране (один кадр, включая удержание и падение пиков)
+    /// @param x, y Левый верхний угол
+    /// @details Смена положения перерисовывает всё. Промежутки между столбцами не затрагиваются
+    /// @returns Количество записанных байт
+    usize render(const FrameView &target, Pixel x, Pixel y) noexcept {
+        if (not target.isValid()) { return 0; }
+
+        if (x != last_x or y != last_y) {
+            last_x = x;
+            last_y = y;
+            redraw_all = true;
+        }
+
+        usize written = 0;
+        auto column = x;
+
+        for (u8 i = 0; i < Bars; ++i, column = static_cast<Pixel>(column + bar_width + gap)) {
+            const Pixel level = wanted[i];
+            updatePeak(i);
+
+            if (redraw_all) {
+                written += span(target, column, y, 0, static_cast<Pixel>(height - level), not on);
+                written += span(target, column, y, static_cast<Pixel>(height - level), height, on);
+                shown_peak[i] = 0;
+            } else if (level > shown[i]) {
+                written += span(target, column, y, static_cast<Pixel>(height - level), static_cast<Pixel>(height - shown[i]), on);
+            } else if (level < shown[i]) {
+                written += span(target, column, y, static_cast<Pixel>(height - shown[i]), static_cast<Pixel>(height - level), not on);
+            }
+
+            shown[i] = level;
+
+            // Метка пика - верхняя строка столбца высотой peak, видна над столбцом.
+            // Старая метка, оказавшаяся внутри выросшего столбца, уже закрашена
+            const Pixel marker = peak_hold != 0 and peak[i] > level ? peak[i] : 0;
+            if (marker == shown_peak[i]) { continue; }
+
+            if (shown_peak[i] > level) {
+                const auto row = static_cast<Pixel>(height - shown_peak[i]);
+                written += span(target, column, y, row, static_cast<Pixel>(row + 1), not on);
+            }
+            if (marker != 0) {
+                const auto row = static_cast<Pixel>(height - marker);
+                written += span(target, column, y, row, static_cast<Pixel>(row + 1), on);
+            }
+            shown_peak[i] = marker;
+        }
+
+        redraw_all = false;
+        return written;
+    }
+
+private:
+    BarGraph(Pixel bar_width, Pixel gap, Pixel height, u16 max_value, bool on) noexcept :
+        bar_width{bar_width},
+        gap{gap},
+        height{height},
+        max_value{max_value},
+        scale{((static_cast<u32>(height) << 16) + max_value - 1) / max_value},
+        on{on} {}
+
+    /// @brief Удержание и падение пика
+    void updatePeak(u8 index) noexcept {
+        if (wanted[index] >= peak[index]) {
+            peak[index] = wanted[index];
+            hold[index] = peak_hold;
+        } else if (hold[index] != 0) {
+            hold[index] -= 1;
+        } else {
+            peak[index] = static_cast<Pixel>(std::max<int>(wanted[index], peak[index] - peak_fall));
+        }
+    }
+
+    /// @brief Записать строки [row_begin, row_end) столбца
+    /// @details Маски строк считаются один раз, затем страница пишется во все столбцы бара
+    /// @returns Количество записанных байт
+    usize span(const FrameView &target, Pixel x, Pixel y, Pixel row_begin, Pixel row_end, bool value) const noexcept {
+        // Отсечение по области
+        const auto top = static_cast<Pixel>(std::max(y + row_begin, 0));
+        const auto bottom = static_cast<Pixel>(std::min(y + row_end, static_cast<int>(target.height)) - 1);
+        const auto left = static_cast<Pixel>(std::max(static_cast<int>(x), 0));
+        const auto right = static_cast<Pixel>(std::min(x + bar_width, static_cast<int>(target.width)));
+        if (top > bottom or left >= right) { return 0; }
+
+        const Pixel abs_top = target.toAbsoluteY(top);
+        const Pixel abs_bottom = target.toAbsoluteY(bottom);
+        const auto first_page = static_cast<Pixel>(abs_top >> 3);
+        const auto last_page = static_cast<Pixel>(abs_bottom >> 3);
+
+        for (Pixel page = first_page; page <= last_page; ++page) {
+            const auto mask = FrameView::createPageMask(
+                static_cast<u8>(page == first_page ? abs_top & 0x07 : 0),
+                static_cast<u8>(page == last_page ? abs_bottom & 0x07 : 7));
+
+            for (Pixel column = left; column < right; ++column) {
+                target.writeData(target.toAbsoluteX(column), page, mask, value);
+            }
+        }
+
+        return static_cast<usize>((last_page - first_page + 1) * (right - left));
+    }
+};
+
+}// namespace kf::gfx
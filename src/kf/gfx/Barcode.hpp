@@ -0,0 +1,368 @@
+#pragma once
+
+#include <algorithm>
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Линейные штрихкоды (Code 128, EAN-13)
+/// @details Каждый штрих - столбцы на всю высоту кода: маски первой и последней страницы
+/// вычисляются один раз, столбец записывается побайтово по страницам.
+/// Символы кодируются потоково, без буферов
+namespace barcode {
+
+/// @brief Ошибки
+enum class Error : u8 {
+
+    /// @brief Символ вне набора кода
+    BadCharacter,
+
+    /// @brief Неверная длина данных
+    BadLength,
+
+    /// @brief Контрольная цифра не совпадает
+    BadChecksum,
+};
+
+/// @brief Свободная зона Code 128 в модулях
+static constexpr u8 code128_quiet = 10;
+
+/// @brief Свободная зона EAN-13 слева в модулях
+static constexpr u8 ean13_quiet_left = 11;
+
+/// @brief Свободная зона EAN-13 справа в модулях
+static constexpr u8 ean13_quiet_right = 7;
+
+/// @brief Запись штрихов и пробелов слева направо
+/// @details Значения столбцов копятся в полосе и записываются блоками:
+/// страница за страницей по соседним байтам
+struct BarWriter final {
+
+    /// @brief Ширина полосы в столбцах
+    static constexpr Pixel strip_width = 64;
+
+private:
+    /// @brief Область
+    FrameView target;
+
+    /// @brief Текущий столбец
+    Pixel x;
+
+    /// @brief Ширина модуля в пикселях
+    u8 module;
+
+    /// @brief Значение пикселей штрихов
+    bool on;
+
+    /// @brief Первая страница (абсолютная)
+    Pixel first_page{0};
+
+    /// @brief Последняя страница (абсолютная)
+    Pixel last_page{-1};
+
+    /// @brief Маска строк первой страницы
+    u8 first_mask{0};
+
+    /// @brief Маска строк последней страницы
+    u8 last_mask{0};
+
+    /// @brief Столбец первого байта полосы
+    Pixel strip_x{0};
+
+    /// @brief Байт страницы для столбцов полосы (0x00 или 0xFF)
+    u8 strip[strip_width]{};
+
+    /// @brief Заполнено столбцов полосы
+    Pixel count{0};
+
+public:
+    /// @param x, y Левый верхний угол
+    /// @param height Высота штрихов
+    /// @param module Ширина модуля в пикселях
+    /// @param on Значение пикселей штрихов (пробелы - обратное)
+    BarWriter(const FrameView &target, Pixel x, Pixel y, Pixel height, u8 module, bool on) noexcept :
+        target{target}, x{x}, module{module}, on{on} {
+        const Pixel top = std::max(y, static_cast<Pixel>(0));
+        const auto bottom = static_cast<Pixel>(std::min(y + height, static_cast<int>(target.height)) - 1);
+        if (not target.isValid() or top > bottom) { return; }
+
+        const Pixel abs_top = target.toAbsoluteY(top);
+        const Pixel abs_bottom = target.toAbsoluteY(bottom);
+        first_page = static_cast<Pixel>(abs_top >> 3);
+        last_page = static_cast<Pixel>(abs_bottom >> 3);
+        first_mask = FrameView::createPageMask(static_cast<u8>(abs_top & 0x07), 7);
+        last_mask = FrameView::createPageMask(0, static_cast<u8>(abs_bottom & 0x07));
+
+        if (first_page == last_page) {
+            first_mask &= last_mask;
+            last_mask = first_mask;
+        }
+    }
+
+    /// @brief Записать модули одного цвета
+    void run(u8 modules, bool bar) noexcept {
+        const auto end = static_cast<Pixel>(x + modules * module);
+        const Pixel left = std::max(x, static_cast<Pixel>(0));
+        const Pixel right = std::min(end, target.width);
+        x = end;
+        if (first_mask == 0 or left >= right) { return; }
+
+        if (count == 0) { strip_x = left; }
+
+        const auto data = static_cast<u8>(bar == on ? 0xFF : 0x00);
+        for (Pixel column = left; column < right;) {
+            const auto n = static_cast<Pixel>(std::min(right - column, strip_width - count));
+            for (Pixel i = 0; i < n; ++i) { strip[count + i] = data; }
+            count = static_cast<Pixel>(count + n);
+            column = static_cast<Pixel>(column + n);
+
+            if (count == strip_width) {
+                flush();
+                strip_x = column;
+            }
+        }
+    }
+
+    /// @brief Записать элементы, начиная со штриха
+    /// @param widths Ширины элементов по 2 бита (ширина - 1), первый элемент в старших битах
+    void elements(u16 widths, u8 elements_count, bool bar = true) noexcept {
+        for (u8 i = elements_count; i > 0; --i, bar = not bar) {
+            run(static_cast<u8>(((widths >> (2 * (i - 1))) & 0x03) + 1), bar);
+        }
+    }
+
+    /// @brief Записать накопленные столбцы
+    void flush() noexcept {
+        // Локальная копия области: запись байт буфера не заставляет перечитывать её поля
+        const FrameView view = target;
+        const Pixel abs_x = view.toAbsoluteX(strip_x);
+
+        const Pixel n = count;
+        const u8 *data = strip;
+
+        const auto write = [&view, abs_x, n, data](Pixel page, u8 mask) {
+            for (Pixel i = 0; i < n; ++i) { view.writeMaskedData(static_cast<Pixel>(abs_x + i), page, data[i], mask); }
+        };
+
+        write(first_page, first_mask);
+        for (Pixel page = static_cast<Pixel>(first_page + 1); page < last_page; ++page) { write(page, 0xFF); }
+        if (last_page > first_page) { write(last_page, last_mask); }
+
+        count = 0;
+    }
+};
+
+/// @brief Code 128 (наборы B и C)
+namespace code128 {
+
+/// @brief Ширины элементов символов 0..105 (штрих, пробел, ... по 2 бита)
+static constexpr u16 patterns[106] = {
+    0x455, 0x545, 0x554, 0x116, 0x125, 0x215, 0x152, 0x161,
+    0x251, 0x512, 0x521, 0x611, 0x059, 0x149, 0x158, 0x095,
+    0x185, 0x194, 0x590, 0x509, 0x518, 0x491, 0x581, 0x848,
+    0x815, 0x905, 0x914, 0x851, 0x941, 0x950, 0x446, 0x464,
+    0x644, 0x026, 0x206, 0x224, 0x062, 0x242, 0x260, 0x422,
+    0x602, 0x620, 0x04A, 0x068, 0x248, 0x086, 0x0A4, 0x284,
+    0x884, 0x428, 0x608, 0x482, 0x4A0, 0x488, 0x806, 0x824,
+    0xA04, 0x842, 0x860, 0xA40, 0x8C0, 0x530, 0xE00, 0x017,
+    0x035, 0x107, 0x134, 0x305, 0x314, 0x053, 0x071, 0x143,
+    0x170, 0x341, 0x350, 0x710, 0x503, 0xC80, 0x701, 0x2C0,
+    0x01D, 0x10D, 0x11C, 0x0D1, 0x1C1, 0x1D0, 0xC11, 0xD01,
+    0xD10, 0x44C, 0x4C4, 0xC44, 0x00E, 0x02C, 0x20C, 0x0C2,
+    0x0E0, 0xC02, 0xC20, 0x08C, 0x0C8, 0x80C, 0xC08, 0x431,
+    0x413, 0x419,
+};
+
+/// @brief Стоп-символ 2331112 (7 элементов)
+static constexpr u16 stop = 0x1A01;
+
+static constexpr u8 switch_c = 99;
+static constexpr u8 switch_b = 100;
+static constexpr u8 start_b = 104;
+static constexpr u8 start_c = 105;
+
+/// @brief Количество цифр подряд начиная с text
+[[nodiscard]] inline usize digits(const char *text) noexcept {
+    usize count = 0;
+    while (text[count] >= '0' and text[count] <= '9') { count += 1; }
+    return count;
+}
+
+/// @brief Кодировать текст (ASCII 32..127) в значения символов, включая старт и контрольный символ
+/// @details Серии от 4 цифр в начале или конце и от 6 цифр в середине кодируются набором C (2 цифры на символ)
+/// @param emit <code>void(u8 value)</code>
+/// @returns Количество символов без стоп-символа
+template<typename Emit> Result<usize, Error> encode(const char *text, Emit &&emit) noexcept {
+    if (*text == '\0') { return Error::BadLength; }
+    for (const char *c = text; *c != '\0'; ++c) {
+        if (static_cast<u8>(*c) < 32 or static_cast<u8>(*c) > 127) { return Error::BadCharacter; }
+    }
+
+    usize count = 0;
+    u32 checksum = 0;
+    const auto put = [&](u8 value) {
+        checksum += value * (count == 0 ? 1 : count);
+        count += 1;
+        emit(value);
+    };
+
+    // Набор C выгоден для серии цифр, если она длиннее переключения туда и обратно
+    const auto worth_c = [](const char *at, bool at_start) {
+        const usize run = digits(at);
+        return run >= (at_start or at[run] == '\0' ? 4u : 6u) or (at_start and run == 2 and at[2] == '\0');
+    };
+
+    bool set_c = worth_c(text, true);
+    put(set_c ? start_c : start_b);
+
+    for (const char *c = text; *c != '\0';) {
+        if (set_c) {
+            if (digits(c) >= 2) {
+                put(static_cast<u8>((c[0] - '0') * 10 + (c[1] - '0')));
+                c += 2;
+                continue;
+            }
+            put(switch_b);
+            set_c = false;
+        }
+
+        // Нечётная серия: первая цифра набором B
+        if (worth_c(c, false) and digits(c) % 2 == 0) {
+            put(switch_c);
+            set_c = true;
+            continue;
+        }
+
+        put(static_cast<u8>(*c - 32));
+        c += 1;
+    }
+
+    emit(static_cast<u8>(checksum % 103));
+    return count + 1;
+}
+
+/// @brief Ширина кода в пикселях вместе со свободными зонами
+[[nodiscard]] inline Result<Pixel, Error> width(const char *text, u8 module = 1) noexcept {
+    const auto result = encode(text, [](u8) {});
+    if (not result.isOk()) { return result.error().value(); }
+
+    return static_cast<Pixel>((2 * code128_quiet + result.ok().value() * 11 + 13) * module);
+}
+
+/// @brief Отрисовать код со свободными зонами
+/// @param x, y Левый верхний угол свободной зоны
+/// @param height Высота штрихов
+/// @param module Ширина модуля в пикселях
+/// @param on Значение пикселей штрихов. По умолчанию штрихи гасятся: код на OLED выглядит как напечатанный
+/// @returns Ширина в пикселях
+inline Result<Pixel, Error> draw(
+    const FrameView &target,
+    Pixel x,
+    Pixel y,
+    Pixel height,
+    const char *text,
+    u8 module = 1,
+    bool on = false) noexcept {
+    const auto size = width(text, module);
+    if (not size.isOk()) { return size; }
+
+    BarWriter writer{target, x, y, height, module, on};
+    writer.run(code128_quiet, false);
+    encode(text, [&writer](u8 value) { writer.elements(patterns[value], 6); });
+    writer.elements(stop, 7);
+    writer.run(code128_quiet, false);
+    writer.flush();
+
+    return size;
+}
+
+}// namespace code128
+
+/// @brief EAN-13
+namespace ean13 {
+
+/// @brief Ширины элементов кодов L (пробел, штрих, пробел, штрих по 2 бита)
+/// @details Код R - те же ширины, начиная со штриха; код G - ширины L в обратном порядке
+static constexpr u8 digit_widths[10] = {
+    0x90, 0x54, 0x45, 0x30, 0x09, 0x18, 0x03, 0x21, 0x12, 0x81,
+};
+
+/// @brief Чётность левой половины по первой цифре (бит 5 - вторая цифра, 1 - код G)
+static constexpr u8 parity[10] = {
+    0b000000, 0b001011, 0b001101, 0b001110, 0b010011, 0b011001, 0b011100, 0b010101, 0b010110, 0b011010,
+};
+
+/// @brief Ширина кода в пикселях вместе со свободными зонами
+[[nodiscard]] inline constexpr Pixel width(u8 module = 1) noexcept {
+    return static_cast<Pixel>((ean13_quiet_left + 95 + ean13_quiet_right) * module);
+}
+
+/// @brief Контрольная цифра для 12 цифр
+[[nodiscard]] inline u8 checkDigit(const char *digits) noexcept {
+    u32 sum = 0;
+    for (u8 i = 0; i < 12; ++i) { sum += (digits[i] - '0') * (i % 2 == 0 ? 1 : 3); }
+    return static_cast<u8>((10 - sum % 10) % 10);
+}
+
+/// @brief Отрисовать код со свободными зонами
+/// @param digits 12 цифр (контрольная вычисляется) или 13 (контрольная проверяется)
+/// @param x, y Левый верхний угол свободной зоны
+/// @param height Высота штрихов
+/// @param module Ширина модуля в пикселях
+/// @param on Значение пикселей штрихов. По умолчанию штрихи гасятся
+/// @returns Ширина в пикселях
+inline Result<Pixel, Error> draw(
+    const FrameView &target,
+    Pixel x,
+    Pixel y,
+    Pixel height,
+    const char *digits,
+    u8 module = 1,
+    bool on = false) noexcept {
+    u8 length = 0;
+    for (; digits[length] != '\0'; ++length) {
+        if (length == 13) { return Error::BadLength; }
+        if (digits[length] < '0' or digits[length] > '9') { return Error::BadCharacter; }
+    }
+    if (length != 12 and length != 13) { return Error::BadLength; }
+
+    const u8 check = checkDigit(digits);
+    if (length == 13 and digits[12] - '0' != check) { return Error::BadChecksum; }
+
+    const auto digit = [digits, check](u8 i) { return static_cast<u8>(i == 12 ? check : digits[i] - '0'); };
+    const u8 left_parity = parity[digit(0)];
+
+    BarWriter writer{target, x, y, height, module, on};
+    writer.run(ean13_quiet_left, false);
+    writer.elements(0b000000, 3);
+
+    for (u8 i = 1; i <= 6; ++i) {
+        const u8 widths = digit_widths[digit(i)];
+
+        if ((left_parity >> (6 - i)) & 1) {
+            // G: ширины L в обратном порядке
+            const auto reversed = static_cast<u8>(
+                (widths & 0x03) << 6 | (widths & 0x0C) << 2 | (widths & 0x30) >> 2 | (widths & 0xC0) >> 6);
+            writer.elements(reversed, 4, false);
+        } else {
+            writer.elements(widths, 4, false);
+        }
+    }
+
+    writer.elements(0b0000000000, 5, false);
+    for (u8 i = 7; i <= 12; ++i) { writer.elements(digit_widths[digit(i)], 4); }
+    writer.elements(0b000000, 3);
+    writer.run(ean13_quiet_right, false);
+    writer.flush();
+
+    return width(module);
+}
+
+}// namespace ean13
+}// namespace barcode
+}// namespace kf::gfx
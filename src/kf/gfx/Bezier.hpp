@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <kf/units.hpp>
+
+
+namespace kf::gfx {
+
+/// @brief Квадратичные и кубические кривые Безье в фиксированной точке
+/// @details Координаты - Q8 (256 = 1 пиксель). Кривая делится пополам (де Кастельжо)
+/// до тех пор, пока отклонение контрольных точек от хорды не станет меньше допуска,
+/// после чего выдаётся конец отрезка. Деление идёт на стеке фиксированной глубины без рекурсии,
+/// поэтому на прямых участках отрезков мало, на крутых изгибах - больше
+namespace bezier {
+
+/// @brief Дробных бит координат
+static constexpr u8 fraction_bits = 8;
+
+/// @brief 1 пиксель в Q8
+static constexpr i32 one = 1 << fraction_bits;
+
+/// @brief Допуск по умолчанию - четверть пикселя
+static constexpr i32 default_tolerance = one / 4;
+
+/// @brief Предельная глубина деления (не более 2^max_depth отрезков на кривую)
+static constexpr u8 max_depth = 8;
+
+/// @brief Точка в Q8
+struct Point final {
+
+    /// @brief X, Q8
+    i32 x;
+
+    /// @brief Y, Q8
+    i32 y;
+};
+
+/// @brief Точка из пиксельных координат
+[[nodiscard]] constexpr Point fromPixels(Pixel x, Pixel y) noexcept {
+    return Point{x * one, y * one};
+}
+
+/// @brief Координата Q8 в пиксель (с округлением)
+[[nodiscard]] constexpr Pixel toPixel(i32 value) noexcept {
+    return static_cast<Pixel>((value + one / 2) >> fraction_bits);
+}
+
+/// @brief Середина отрезка
+[[nodiscard]] constexpr Point middle(Point a, Point b) noexcept {
+    return Point{(a.x + b.x) >> 1, (a.y + b.y) >> 1};
+}
+
+/// @brief Разбить квадратичную кривую на отрезки
+/// @param emit Вызывается с концом каждого отрезка по порядку (начальная точка p0 не выдаётся)
+/// @param tolerance Допустимое отклонение от кривой по каждой оси, Q8
+/// @details |координаты| < 2^23
+template<typename Emit> void quadratic(Point p0, Point p1, Point p2, Emit &&emit, i32 tolerance = default_tolerance) noexcept {
+    struct Curve final {
+        Point p0, p1, p2;
+        u8 depth;
+    };
+
+    Curve stack[max_depth + 1];
+    u8 size = 0;
+    stack[size++] = Curve{p0, p1, p2, 0};
+
+    while (size != 0) {
+        const Curve c = stack[--size];
+
+        // Отклонение середины кривой от хорды: (p0 - 2 p1 + p2) / 4
+        const i32 dx = std::abs(c.p0.x - 2 * c.p1.x + c.p2.x);
+        const i32 dy = std::abs(c.p0.y - 2 * c.p1.y + c.p2.y);
+
+        if (c.depth == max_depth or std::max(dx, dy) <= 4 * tolerance) {
+            emit(c.p2);
+            continue;
+        }
+
+        const Point a = middle(c.p0, c.p1);
+        const Point b = middle(c.p1, c.p2);
+        const Point m = middle(a, b);
+        const auto depth = static_cast<u8>(c.depth + 1);
+
+        // Правая половина ниже левой: левая выдаётся первой
+        stack[size++] = Curve{m, b, c.p2, depth};
+        stack[size++] = Curve{c.p0, a, m, depth};
+    }
+}
+
+/// @brief Разбить кубическую кривую на отрезки
+/// @param emit Вызывается с концом каждого отрезка по порядку (начальная точка p0 не выдаётся)
+/// @param tolerance Допустимое отклонение от кривой по каждой оси, Q8
+/// @details |координаты| < 2^23
+template<typename Emit> void cubic(Point p0, Point p1, Point p2, Point p3, Emit &&emit, i32 tolerance = default_tolerance) noexcept {
+    struct Curve final {
+        Point p0, p1, p2, p3;
+        u8 depth;
+    };
+
+    Curve stack[max_depth + 1];
+    u8 size = 0;
+    stack[size++] = Curve{p0, p1, p2, p3, 0};
+
+    while (size != 0) {
+        const Curve c = stack[--size];
+
+        // Оценка отклонения от хорды: max(|3 p1 - 2 p0 - p3|, |3 p2 - p0 - 2 p3|) / 4
+        const i32 ux = std::abs(3 * c.p1.x - 2 * c.p0.x - c.p3.x);
+        const i32 uy = std::abs(3 * c.p1.y - 2 * c.p0.y - c.p3.y);
+        const i32 vx = std::abs(3 * c.p2.x - c.p0.x - 2 * c.p3.x);
+        const i32 vy = std::abs(3 * c.p2.y - c.p0.y - 2 * c.p3.y);
+
+        if (c.depth == max_depth or std::max(std::max(ux, uy), std::max(vx, vy)) <= 4 * tolerance) {
+            emit(c.p3);
+            continue;
+        }
+
+        const Point a = middle(c.p0, c.p1);
+        const Point b = middle(c.p1, c.p2);
+        const Point d = middle(c.p2, c.p3);
+        const Point ab = middle(a, b);
+        const Point bd = middle(b, d);
+        const Point m = middle(ab, bd);
+        const auto depth = static_cast<u8>(c.depth + 1);
+
+        stack[size++] = Curve{m, bd, d, c.p3, depth};
+        stack[size++] = Curve{c.p0, a, ab, m, depth};
+    }
+}
+
+}// namespace bezier
+}// namespace kf::gfx
@@ -5,6 +5,22 @@
 
 namespace kf::gfx {
 
+/// @brief Представление битмапа с размерами, известными во время выполнения
+struct BitMapView final {
+
+    /// @brief Буфер (страничный формат, 8 пикселей на байт)
+    const u8 *buffer;
+
+    /// @brief Ширина
+    Pixel width;
+
+    /// @brief Высота
+    Pixel height;
+
+    /// @brief Количество страниц
+    [[nodiscard]] inline constexpr Pixel pages() const { return static_cast<Pixel>((height + 7) / 8); }
+};
+
 /// @brief БитМап изображение
 template<Pixel W, Pixel H> struct BitMap final {
 
@@ -21,6 +37,9 @@ template<Pixel W, Pixel H> struct BitMap final {
     const u8 buffer[W * pages];
 
     BitMap() = delete;
+
+    /// @brief Представление битмапа
+    [[nodiscard]] inline constexpr BitMapView view() const { return {buffer, W, H}; }
 };
 
 }// namespace kf::gfx
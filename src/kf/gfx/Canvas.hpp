@@ -1,12 +1,16 @@
 #pragma once
 
 #include <array>
-#include <cmath>
+#include <cstdlib>
 #include <kf/Result.hpp>
 
 #include "kf/gfx/BitMap.hpp"
+#include "kf/gfx/DrawRecorder.hpp"
 #include "kf/gfx/Font.hpp"
 #include "kf/gfx/FrameView.hpp"
+#include "kf/gfx/Morphology.hpp"
+#include "kf/gfx/Path.hpp"
+#include "kf/gfx/Trig.hpp"
 
 
 namespace kf::gfx {
@@ -14,6 +18,9 @@ namespace kf::gfx {
 /// @brief Инструменты для рисования графических примитивов
 struct Canvas {
 
+    /// @brief Потоковый вывод текста по символам
+    friend struct DrawInterpreter;
+
     /// @brief Режимы отрисовки фигур
     enum class Mode : u8 {
 
@@ -49,6 +56,14 @@ public:
     /// @brief Автоматический перенос строки
     bool auto_next_line{false};
 
+    /// @brief Текст с контуром
+    /// @details Глифы рисуются без фона и обводятся на пиксель цветом фона
+    bool outline{false};
+
+    /// @brief Журнал вызовов (режим захвата)
+    /// @details nullptr - захват выключен. Наследуется дочерними областями
+    DrawRecorder *recorder{nullptr};
+
     explicit Canvas(const FrameView &frame, const Font &font = Font::blank()) noexcept:
         frame{frame}, current_font{&font} {}
 
@@ -65,7 +80,9 @@ public:
         const auto frame_result = frame.sub(width, height, offset_x, offset_y);
 
         if (frame_result.isOk()) {
-            return {Canvas{frame_result.ok().value(), *current_font}};
+            Canvas child{frame_result.ok().value(), *current_font};
+            child.recorder = recorder;
+            return {child};
         } else {
             return {frame_result.error().value()};
         }
@@ -90,7 +107,9 @@ public:
         /// @details 0 .. (parent.height() - sub_height)
         Pixel offset_y
     ) {
-        return Canvas{frame.subUnchecked(width, height, offset_x, offset_y), *current_font};
+        Canvas child{frame.subUnchecked(width, height, offset_x, offset_y), *current_font};
+        child.recorder = recorder;
+        return child;
     }
 
     /// @brief Установить шрифт
@@ -165,24 +184,34 @@ public:
 
     /// @brief Заполняет весь фрейм
     inline void fill(bool value) const noexcept {
+        if (nullptr != recorder) { recorder->fill(frame, value); }
         frame.fill(value);
     }
 
     /// @brief Рисует точку в указанных координатах
     inline void dot(Pixel x, Pixel y, bool on = true) const noexcept {
+        if (nullptr != recorder) { recorder->dot(frame, x, y, on); }
         frame.setPixel(x, y, on);
     }
 
     /// @brief Рисует битмап в указанных координатах
     template<Pixel W, Pixel H> inline void bitmap(Pixel x, Pixel y, const BitMap<W, H> &bm, bool on = true) noexcept {
+        bitmap(x, y, bm.view(), on);
+    }
+
+    /// @brief Рисует битмап в указанных координатах
+    void bitmap(Pixel x, Pixel y, const BitMapView &bm, bool on = true) noexcept {
+        if (nullptr != recorder) { recorder->bitmap(frame, x, y, bm, on); }
         frame.drawBitmap(x, y, bm, on);
     }
 
     /// @brief Рисует линию
     void line(Pixel x0, Pixel y0, Pixel x1, Pixel y1, bool on = true) const noexcept {
+        if (nullptr != recorder) { recorder->line(frame, x0, y0, x1, y1, on); }
+
         if (x0 == x1) {
             if (y0 == y1) {
-                dot(x0, y0, on);
+                frame.setPixel(x0, y0, on);
             } else {
                 drawLineVertical(x0, y0, y1, on);
             }
@@ -195,15 +224,68 @@ public:
         }
 
         // алгоритм Брезенхема
-        const auto dx = static_cast<Pixel>(abs(x1 - x0));
-        const auto dy = static_cast<Pixel>(-abs(y1 - y0));
+        const auto dx = static_cast<Pixel>(std::abs(x1 - x0));
+        const auto dy = static_cast<Pixel>(-std::abs(y1 - y0));
         const auto sx = (x0 < x1) ? 1 : -1;
         const auto sy = (y0 < y1) ? 1 : -1;
 
         auto error = dx + dy;
 
         while (true) {
-            dot(x0, y0, on);
+            frame.setPixel(x0, y0, on);
+            if (x0 == x1 and y0 == y1) { break; }
+
+            const auto double_error = 2 * error;
+            if (double_error >= dy) {
+                if (x0 == x1) { break; }
+                error += dy;
+                x0 = static_cast<Pixel>(x0 + sx);
+            }
+            if (double_error <= dx) {
+                if (y0 == y1) { break; }
+                error += dx;
+                y0 = static_cast<Pixel>(y0 + sy);
+            }
+        }
+    }
+
+    /// @brief Рисует линию по шаблону штриховки
+    /// @details Позиция в шаблоне - X для пологих линий, Y для крутых
+    void line(Pixel x0, Pixel y0, Pixel x1, Pixel y1, const LinePattern &pattern, bool on = true) const noexcept {
+        if (nullptr != recorder) { recorder->patternLine(frame, x0, y0, x1, y1, pattern, on); }
+        if (pattern.period() == 0) { return; }
+
+        if (y0 == y1) {
+            frame.drawHorizontalSpan(x0, x1, y0, on, pattern);
+            return;
+        }
+
+        if (x0 == x1) {
+            frame.drawVerticalSpan(x0, y0, y1, on, pattern);
+            return;
+        }
+
+        // алгоритм Брезенхема, смещение в шаблоне сдвигается вместе с основной координатой
+        const auto dx = static_cast<Pixel>(std::abs(x1 - x0));
+        const auto dy = static_cast<Pixel>(-std::abs(y1 - y0));
+        const auto sx = (x0 < x1) ? 1 : -1;
+        const auto sy = (y0 < y1) ? 1 : -1;
+        const bool steep = -dy > dx;
+        const bool forward = steep ? sy > 0 : sx > 0;
+
+        auto error = dx + dy;
+        u8 offset = pattern.offset(steep ? y0 : x0);
+
+        const auto advance = [&]() {
+            if (forward) {
+                offset = static_cast<u8>(offset + 1 == pattern.period() ? 0 : offset + 1);
+            } else {
+                offset = static_cast<u8>(offset == 0 ? pattern.period() - 1 : offset - 1);
+            }
+        };
+
+        while (true) {
+            if ((pattern.bits >> offset) & 1) { frame.setPixel(x0, y0, on); }
             if (x0 == x1 and y0 == y1) { break; }
 
             const auto double_error = 2 * error;
@@ -211,17 +293,129 @@ public:
                 if (x0 == x1) { break; }
                 error += dy;
                 x0 = static_cast<Pixel>(x0 + sx);
+                if (not steep) { advance(); }
             }
             if (double_error <= dx) {
                 if (y0 == y1) { break; }
                 error += dx;
                 y0 = static_cast<Pixel>(y0 + sy);
+                if (steep) { advance(); }
             }
         }
     }
 
     /// @brief Рисует прямоугольник с указанным режимом
     void rect(Pixel x0, Pixel y0, Pixel x1, Pixel y1, Mode mode) noexcept {
+        if (nullptr != recorder) { recorder->rect(frame, x0, y0, x1, y1, static_cast<u8>(mode)); }
+        drawRect(x0, y0, x1, y1, mode);
+    }
+
+    /// @brief Рисует окружность с указанным режимом
+    void circle(Pixel center_x, Pixel center_y, Pixel r, Mode mode) noexcept {
+        if (nullptr != recorder) { recorder->circle(frame, center_x, center_y, r, static_cast<u8>(mode)); }
+        drawCircle(center_x, center_y, r, mode);
+    }
+
+    /// @brief Рисует дугу окружности от угла start до end (по возрастанию угла)
+    /// @details Пиксели дуги совпадают с пикселями границы circle() того же радиуса
+    void arc(Pixel center_x, Pixel center_y, Pixel r, trig::Angle start, trig::Angle end, bool on = true) noexcept {
+        if (nullptr != recorder) { recorder->arc(frame, center_x, center_y, r, start, end, on); }
+        drawArc(center_x, center_y, r, start, end, on);
+    }
+
+    /// @brief Рисует стрелку: отрезок луча под углом angle от радиуса r0 до r1
+    void needle(Pixel center_x, Pixel center_y, Pixel r0, Pixel r1, trig::Angle angle, bool on = true) noexcept {
+        const i16 cosine = trig::cos(angle);
+        const i16 sine = trig::sin(angle);
+
+        line(
+            static_cast<Pixel>(center_x + trig::scale(r0, cosine)),
+            static_cast<Pixel>(center_y + trig::scale(r0, sine)),
+            static_cast<Pixel>(center_x + trig::scale(r1, cosine)),
+            static_cast<Pixel>(center_y + trig::scale(r1, sine)),
+            on);
+    }
+
+    /// @brief Рисует квадратичную кривую Безье от (x0, y0) до (x2, y2) с контрольной точкой (x1, y1)
+    /// @details Кривая разбивается на отрезки с отклонением не более четверти пикселя по каждой оси
+    void quadratic(Pixel x0, Pixel y0, Pixel x1, Pixel y1, Pixel x2, Pixel y2, bool on = true) noexcept {
+        Pixel x = x0, y = y0;
+        bezier::quadratic(
+            bezier::fromPixels(x0, y0),
+            bezier::fromPixels(x1, y1),
+            bezier::fromPixels(x2, y2),
+            [&](bezier::Point p) { lineTo(x, y, p, on); });
+
+        if (x == x0 and y == y0) { line(x0, y0, x0, y0, on); }
+    }
+
+    /// @brief Рисует кубическую кривую Безье от (x0, y0) до (x3, y3) с контрольными точками (x1, y1), (x2, y2)
+    /// @details Кривая разбивается на отрезки с отклонением не более четверти пикселя по каждой оси
+    void cubic(Pixel x0, Pixel y0, Pixel x1, Pixel y1, Pixel x2, Pixel y2, Pixel x3, Pixel y3, bool on = true) noexcept {
+        Pixel x = x0, y = y0;
+        bezier::cubic(
+            bezier::fromPixels(x0, y0),
+            bezier::fromPixels(x1, y1),
+            bezier::fromPixels(x2, y2),
+            bezier::fromPixels(x3, y3),
+            [&](bezier::Point p) { lineTo(x, y, p, on); });
+
+        if (x == x0 and y == y0) { line(x0, y0, x0, y0, on); }
+    }
+
+    /// @brief Рисует контуры пути
+    template<u16 Capacity, u8 Contours> inline void stroke(const Path<Capacity, Contours> &path, bool on = true) noexcept {
+        stroke(path.view(), on);
+    }
+
+    /// @brief Рисует контуры пути
+    void stroke(const PathView &path, bool on = true) noexcept {
+        u16 begin = 0;
+        for (u8 c = 0; c < path.contours_count; ++c) {
+            const PathContour &contour = path.contours[c];
+            if (contour.end == begin) { continue; }
+
+            Pixel x = bezier::toPixel(path.points[begin].x);
+            Pixel y = bezier::toPixel(path.points[begin].y);
+            line(x, y, x, y, on);
+
+            for (u16 i = static_cast<u16>(begin + 1); i < contour.end; ++i) { lineTo(x, y, path.points[i], on); }
+            if (contour.closed) { lineTo(x, y, path.points[begin], on); }
+
+            begin = contour.end;
+        }
+    }
+
+    /// @brief Заливает путь (контуры замыкаются автоматически)
+    /// @details Заполняются пиксели, центры которых внутри пути. Пересечения строки
+    /// с рёбрами хранятся на стеке: Capacity * 4 байт
+    template<u16 Capacity, u8 Contours> void fillPath(const Path<Capacity, Contours> &path, FillRule rule = FillRule::NonZero, bool on = true) noexcept {
+        i32 crossings[Capacity];
+        drawPathFill(path.view(), crossings, rule, on);
+    }
+
+    /// @brief Установить позицию курсора
+    void setCursor(Pixel x, Pixel y) noexcept {
+        cursor_x = x;
+        cursor_y = y;
+    }
+
+    /// @brief Рисует текст с использованием текущего шрифта.
+    /// @param text C-style string
+    /// @param on Цвет текста
+    /// @details <code>'\\n'</code> для перехода на новую строку
+    /// @details <code>'\\t'</code> для табуляции
+    /// @details <code>'\\x80'</code> для нормального текста
+    /// @details <code>'\\x81'</code> для инверсии текста
+    /// @details <code>'\\x82'</code> для установки курсора по центру фрейма
+    void text(const char *text, bool on = true) noexcept {
+        if (nullptr != recorder) { recorder->text(frame, *current_font, cursor_x, cursor_y, auto_next_line, outline, text, on); }
+        drawText(text, on);
+    }
+
+private:
+    /// @brief Рисует прямоугольник с указанным режимом
+    void drawRect(Pixel x0, Pixel y0, Pixel x1, Pixel y1, Mode mode) noexcept {
         // Нормализация координат
         if (x0 > x1) { std::swap(x0, x1); }
         if (y0 > y1) { std::swap(y0, y1); }
@@ -229,6 +423,13 @@ public:
         const bool value = getModeValue(mode);
 
         if (isFillMode(mode)) {
+            // Отсечение по границам фрейма
+            x0 = std::max(x0, static_cast<Pixel>(0));
+            y0 = std::max(y0, static_cast<Pixel>(0));
+            x1 = std::min(x1, maxX());
+            y1 = std::min(y1, maxY());
+            if (x0 > x1 or y0 > y1) { return; }
+
             // Оптимизированная заливка через subview
             const auto width = static_cast<Pixel>(x1 - x0 + 1);
             const auto height = static_cast<Pixel>(y1 - y0 + 1);
@@ -239,15 +440,15 @@ public:
             drawLineHorizontal(x0, y1, x1, value);// Нижняя сторона
 
             // Боковые стороны (исключая углы)
-            for (auto y = static_cast<Pixel>(y0 + 1); y < y1; y++) {
-                frame.setPixel(x0, y, value);
-                frame.setPixel(x1, y, value);
+            if (y1 - y0 > 1) {
+                drawLineVertical(x0, static_cast<Pixel>(y0 + 1), static_cast<Pixel>(y1 - 1), value);
+                drawLineVertical(x1, static_cast<Pixel>(y0 + 1), static_cast<Pixel>(y1 - 1), value);
             }
         }
     }
 
     /// @brief Рисует окружность с указанным режимом
-    void circle(Pixel center_x, Pixel center_y, Pixel r, Mode mode) noexcept {
+    void drawCircle(Pixel center_x, Pixel center_y, Pixel r, Mode mode) noexcept {
         const bool value = getModeValue(mode);
 
         Pixel x = r;
@@ -298,78 +499,187 @@ public:
         }
     }
 
-    /// @brief Установить позицию курсора
-    void setCursor(Pixel x, Pixel y) noexcept {
-        cursor_x = x;
-        cursor_y = y;
-    }
+    /// @brief Рисует дугу: точки границы окружности, угол которых попадает в [start, end]
+    void drawArc(Pixel center_x, Pixel center_y, Pixel r, trig::Angle start, trig::Angle end, bool value) noexcept {
+        const auto sweep = static_cast<trig::Angle>(end - start);
 
-    /// @brief Рисует текст с использованием текущего шрифта.
-    /// @param text C-style string
-    /// @param on Цвет текста
-    /// @details <code>'\\n'</code> для перехода на новую строку
-    /// @details <code>'\\t'</code> для табуляции
-    /// @details <code>'\\x80'</code> для нормального текста
-    /// @details <code>'\\x81'</code> для инверсии текста
-    /// @details <code>'\\x82'</code> для установки курсора по центру фрейма
-    void text(const char *text, bool on = true) noexcept {
-        for (; *text != '\0'; text += 1) {
-            if (*text == '\x80') {
-                on = true;
-                continue;
-            }
-            if (*text == '\x81') {
-                on = false;
-                continue;
-            }
-            if (*text == '\x82') {
-                const auto new_x = centerX();
-                clearLineSegment(new_x, on);
-                cursor_x = new_x;
-                continue;
-            }
-            if (*text == '\n') {
-                clearLineSegment(maxX(), on);
-                nextLine();
-                continue;
+        const auto point = [this, center_x, center_y, start, sweep, value](Pixel dx, Pixel dy) {
+            if (static_cast<trig::Angle>(trig::atan2(dy, dx) - start) > sweep) { return; }
+            frame.setPixel(static_cast<Pixel>(center_x + dx), static_cast<Pixel>(center_y + dy), value);
+        };
+
+        Pixel x = r;
+        Pixel y = 0;
+        auto err = 0;
+
+        // Шаги как в drawCircle
+        while (x >= y) {
+            y++;
+            err += 2 * y + 1;
+
+            if (2 * (err - x) + 1 > 0) {
+                x--;
+                err -= 2 * x + 1;
             }
-            if (*text == '\t') {
-                const auto tab_width = tabWidth();
-                const auto new_x = static_cast<Pixel>(((cursor_x / tab_width) + 1) * tab_width);
-                clearLineSegment(new_x, on);
-                cursor_x = new_x;
-                continue;
+
+            for (u8 pass = 0; pass < (x != y ? 2 : 1); ++pass) {
+                const Pixel a = pass == 0 ? x : y;
+                const Pixel b = pass == 0 ? y : x;
+                point(a, b);
+                point(b, a);
+                point(static_cast<Pixel>(-b), a);
+                point(static_cast<Pixel>(-a), b);
+                point(static_cast<Pixel>(-a), static_cast<Pixel>(-b));
+                point(static_cast<Pixel>(-b), static_cast<Pixel>(-a));
+                point(b, static_cast<Pixel>(-a));
+                point(a, static_cast<Pixel>(-b));
             }
+        }
+    }
 
-            if (cursor_x > maxGlyphX()) {
-                clearLineSegment(maxX(), on);
+    /// @brief Продолжает ломаную из (x, y) отрезком до точки p (Q8), отрезки нулевой длины пропускаются
+    void lineTo(Pixel &x, Pixel &y, bezier::Point p, bool on) const noexcept {
+        const Pixel next_x = bezier::toPixel(p.x);
+        const Pixel next_y = bezier::toPixel(p.y);
+        if (next_x == x and next_y == y) { return; }
 
-                if (auto_next_line) {
-                    nextLine();
-                } else {
-                    return;
+        line(x, y, next_x, next_y, on);
+        x = next_x;
+        y = next_y;
+    }
+
+    /// @brief Заливает путь построчно
+    /// @param crossings Буфер пересечений не меньше количества вершин
+    /// @details Для каждой строки пересечения с рёбрами (X в Q8, младший бит - направление ребра)
+    /// сортируются вставками, промежутки внутри пути выводятся горизонтальными отрезками
+    void drawPathFill(const PathView &path, i32 *crossings, FillRule rule, bool on) const noexcept {
+        if (path.points_count < 3) { return; }
+
+        i32 top = path.points[0].y;
+        i32 bottom = top;
+        for (u16 i = 1; i < path.points_count; ++i) {
+            top = std::min(top, path.points[i].y);
+            bottom = std::max(bottom, path.points[i].y);
+        }
+
+        // Строки, центры которых в [top, bottom)
+        constexpr i32 half = bezier::one / 2;
+        const auto first_row = static_cast<Pixel>(std::max<i32>((top - half + bezier::one - 1) >> bezier::fraction_bits, 0));
+        const auto last_row = static_cast<Pixel>(std::min<i32>(((bottom - half + bezier::one - 1) >> bezier::fraction_bits) - 1, maxY()));
+
+        for (Pixel y = first_row; y <= last_row; ++y) {
+            const i32 center = y * bezier::one + half;
+            u16 count = 0;
+
+            u16 begin = 0;
+            for (u8 c = 0; c < path.contours_count; ++c) {
+                const u16 end = path.contours[c].end;
+
+                for (u16 i = begin; i < end; ++i) {
+                    const bezier::Point &a = path.points[i];
+                    const bezier::Point &b = path.points[i + 1 == end ? begin : i + 1];
+                    if (a.y == b.y) { continue; }
+
+                    const bool down = a.y < b.y;
+                    const bezier::Point &low = down ? a : b;
+                    const bezier::Point &high = down ? b : a;
+                    if (center < low.y or center >= high.y) { continue; }
+
+                    const auto run = static_cast<u64>(std::abs(high.x - low.x)) * static_cast<u64>(center - low.y) / static_cast<u64>(high.y - low.y);
+                    const i32 x = high.x >= low.x ? low.x + static_cast<i32>(run) : low.x - static_cast<i32>(run);
+
+                    // Вставка по возрастанию
+                    const i32 crossing = x * 2 + down;
+                    u16 j = count++;
+                    for (; j > 0 and crossings[j - 1] > crossing; --j) { crossings[j] = crossings[j - 1]; }
+                    crossings[j] = crossing;
                 }
+
+                begin = end;
             }
 
-            if (cursor_y > maxGlyphY()) { return; }
+            i32 winding = 0;
+            for (u16 i = 0; i + 1 < count; ++i) {
+                winding += rule == FillRule::EvenOdd ? 1 : ((crossings[i] & 1) ? 1 : -1);
+                const bool inside = rule == FillRule::EvenOdd ? (winding & 1) : winding != 0;
+                if (not inside) { continue; }
+
+                // Пиксели, центры которых в [left, right)
+                const i32 left = crossings[i] >> 1;
+                const i32 right = crossings[i + 1] >> 1;
+                const auto x0 = static_cast<Pixel>(std::max<i32>((left - half + bezier::one - 1) >> bezier::fraction_bits, 0));
+                const auto x1 = static_cast<Pixel>(std::min<i32>(((right - half + bezier::one - 1) >> bezier::fraction_bits) - 1, maxX()));
+                if (x0 <= x1) { line(x0, y, x1, y, on); }
+            }
+        }
+    }
+
+    /// @brief Рисует текст с использованием текущего шрифта
+    void drawText(const char *text, bool on) noexcept {
+        for (; *text != '\0'; text += 1) {
+            if (not drawChar(*text, on)) { return; }
+        }
+    }
 
-            drawGlyph(cursor_x, cursor_y, current_font->getGlyph(*text), on);
+    /// @brief Рисует символ текста или выполняет управляющую последовательность
+    /// @param on Цвет текста, изменяется управляющими символами
+    /// @returns false, если вывод строки должен быть прекращён
+    bool drawChar(char c, bool &on) noexcept {
+        if (c == '\x80') {
+            on = true;
+            return true;
+        }
+        if (c == '\x81') {
+            on = false;
+            return true;
+        }
+        if (c == '\x82') {
+            const auto new_x = centerX();
+            clearLineSegment(new_x, on);
+            cursor_x = new_x;
+            return true;
+        }
+        if (c == '\n') {
+            clearLineSegment(maxX(), on);
+            nextLine();
+            return true;
+        }
+        if (c == '\t') {
+            const auto tab_width = tabWidth();
+            const auto new_x = static_cast<Pixel>(((cursor_x / tab_width) + 1) * tab_width);
+            clearLineSegment(new_x, on);
+            cursor_x = new_x;
+            return true;
+        }
 
-            cursor_x = static_cast<Pixel>(cursor_x + current_font->glyph_width);
+        if (cursor_x > maxGlyphX()) {
+            clearLineSegment(maxX(), on);
 
-            if (cursor_x < width()) {
-                drawLineVertical(
-                    cursor_x,
-                    cursor_y,
-                    static_cast<Pixel>(cursor_y + current_font->glyph_height),
-                    not on);
+            if (auto_next_line) {
+                nextLine();
+            } else {
+                return false;
             }
+        }
+
+        if (cursor_y > maxGlyphY()) { return false; }
+
+        drawGlyph(cursor_x, cursor_y, current_font->getGlyph(c), on);
+
+        cursor_x = static_cast<Pixel>(cursor_x + current_font->glyph_width);
 
-            cursor_x = static_cast<Pixel>(cursor_x + 1);
+        if (cursor_x < width() and not outline) {
+            drawLineVertical(
+                cursor_x,
+                cursor_y,
+                static_cast<Pixel>(cursor_y + current_font->glyph_height),
+                not on);
         }
+
+        cursor_x = static_cast<Pixel>(cursor_x + 1);
+        return true;
     }
 
-private:
     /// @brief Рассчитывает размеры областей для разделения
     template<usize N> std::array<Pixel, N> calculateSplitSizes(Pixel total_size, std::array<u8, N> weights) {
         for (auto &w: weights) {
@@ -396,8 +706,11 @@ private:
     }
 
     /// @brief Очистить сегмент строки от курсора
+    /// @details Текст с контуром не имеет фона
     void clearLineSegment(Pixel x, bool on) noexcept {
-        rect(
+        if (outline) { return; }
+
+        drawRect(
             cursor_x,
             cursor_y,
             x,
@@ -423,18 +736,12 @@ private:
 
     /// @brief Рисует горизонтальную линию
     void drawLineHorizontal(Pixel x0, Pixel y, Pixel x1, bool on) const noexcept {
-        if (x0 > x1) { std::swap(x0, x1); }
-        for (Pixel x = x0; x <= x1; x++) {
-            frame.setPixel(x, y, on);
-        }
+        frame.drawHorizontalSpan(x0, x1, y, on);
     }
 
     /// @brief Рисует вертикальную линию
     void drawLineVertical(Pixel x, Pixel y0, Pixel y1, bool on) const noexcept {
-        if (y0 > y1) { std::swap(y0, y1); }
-        for (Pixel y = y0; y <= y1; y++) {
-            frame.setPixel(x, y, on);
-        }
+        frame.drawVerticalSpan(x, y0, y1, on);
     }
 
     /// @brief Рисует 8 симметричных точек окружности
@@ -452,7 +759,7 @@ private:
     /// @brief Рисует глиф
     void drawGlyph(Pixel x, Pixel y, const u8 *glyph, bool on) noexcept {
         if (glyph == nullptr) {
-            rect(
+            drawRect(
                 x,
                 y,
                 static_cast<Pixel>(x + current_font->glyph_width - 1),
@@ -461,13 +768,46 @@ private:
             return;
         }
 
+        // Столбец глифа вместе со строкой интервала под ним
+        const auto mask = static_cast<u16>((1u << (current_font->glyph_height + 1)) - 1);
+
+        if (outline) {
+            drawGlyphOutlined(x, y, glyph, mask, on);
+            return;
+        }
+
         for (u8 col_index = 0; col_index < current_font->glyph_width; ++col_index) {
-            const auto pixel_x = static_cast<Pixel>(x + col_index);
+            const auto column = static_cast<u16>(on ? glyph[col_index] : ~glyph[col_index]);
+            frame.writeColumn(static_cast<Pixel>(x + col_index), y, column, mask);
+        }
+    }
 
-            for (u8 bit_index = 0; bit_index <= current_font->glyph_height; ++bit_index) {
-                const bool lit = glyph[col_index] & (1 << bit_index);
-                frame.setPixel(pixel_x, static_cast<Pixel>(y + bit_index), lit == on);
-            }
+    /// @brief Рисует глиф без фона с контуром цвета фона
+    /// @details Контур - расширение глифа (morphology::dilateBits по столбцам и OR соседних столбцов),
+    /// рисуется от строки y - 1. Контуры соседних глифов попадают только в интервалы между ними,
+    /// поэтому глифы можно рисовать по одному
+    void drawGlyphOutlined(Pixel x, Pixel y, const u8 *glyph, u16 mask, bool on) noexcept {
+        const u8 width = current_font->glyph_width;
+        const auto column = [glyph, mask, width](int index) -> u16 {
+            if (index < 0 or index >= width) { return 0; }
+            return morphology::dilateBits(static_cast<u16>((glyph[index] & mask) << 1));
+        };
+
+        u16 left = 0;
+        u16 current = 0;
+
+        for (int index = -1; index <= width; ++index) {
+            const u16 right = column(index + 1);
+            const auto halo = static_cast<u16>(left | current | right);
+
+            frame.writeColumn(static_cast<Pixel>(x + index), static_cast<Pixel>(y - 1), on ? 0 : 0xFFFF, halo);
+
+            left = current;
+            current = right;
+        }
+
+        for (u8 col_index = 0; col_index < width; ++col_index) {
+            frame.writeColumn(static_cast<Pixel>(x + col_index), y, on ? 0xFFFF : 0, glyph[col_index] & mask);
         }
     }
 };
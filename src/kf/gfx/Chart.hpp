@@ -0,0 +1,290 @@
+#pragma once
+
+#include <algorithm>
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/Canvas.hpp"
+#include "kf/gfx/Font.hpp"
+#include "kf/gfx/FrameView.hpp"
+#include "kf/gfx/LinePattern.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief График с осями, делениями, сеткой и подписями
+/// @details Оформление рисуется один раз в собственный буфер (статический слой) и перерисовывается
+/// только при смене шкалы или invalidate(). Каждый кадр слой накладывается на область дисплея
+/// растровой операцией: Copy вместо очистки перед данными или Or / Xor поверх уже нарисованных данных
+/// @tparam W Ширина графика
+/// @tparam H Высота графика
+template<Pixel W, Pixel H> struct Chart final {
+
+    /// @brief Количество страниц слоя
+    static constexpr Pixel pages = (H + 7) / 8;
+
+    /// @brief Длина деления
+    static constexpr Pixel tick_length = 2;
+
+    /// @brief Ошибки
+    enum class Error : u8 {
+
+        /// @brief min >= max по одной из осей
+        BadRange,
+    };
+
+private:
+    /// @brief Максимальная длина подписи (знак и 10 цифр)
+    static constexpr u8 label_capacity = 12;
+
+    /// @brief Буфер статического слоя
+    u8 layer_buffer[W * pages]{};
+
+    /// @brief Шкала X
+    i32 x_min, x_max;
+
+    /// @brief Шкала Y
+    i32 y_min, y_max;
+
+    /// @brief Область данных (включительно, в координатах графика)
+    Pixel plot_left{0}, plot_top{0}, plot_right{W - 1}, plot_bottom{H - 1};
+
+    /// @brief Слой нужно перерисовать
+    bool dirty{true};
+
+public:
+    /// @brief Шрифт подписей (nullptr - без подписей)
+    const Font *font;
+
+    /// @brief Интервалов между делениями X
+    u8 x_ticks{4};
+
+    /// @brief Интервалов между делениями Y
+    u8 y_ticks{4};
+
+    /// @brief Рисовать сетку
+    bool show_grid{true};
+
+    /// @brief Штриховка сетки
+    LinePattern grid{LinePattern::dotted()};
+
+    /// @brief Значение пикселей оформления
+    bool on{true};
+
+    /// @brief Создать график
+    /// @details После изменения оформления (шрифт, деления, сетка) нужен invalidate()
+    [[nodiscard]] static Result<Chart, Error> create(
+        i32 x_min,
+        i32 x_max,
+        i32 y_min,
+        i32 y_max,
+        const Font *font = nullptr) noexcept {
+        if (x_min >= x_max or y_min >= y_max) { return Error::BadRange; }
+        return Chart{x_min, x_max, y_min, y_max, font};
+    }
+
+    /// @brief Сменить шкалу
+    /// @returns true, если шкала изменилась и слой будет перерисован
+    Result<bool, Error> setScale(i32 new_x_min, i32 new_x_max, i32 new_y_min, i32 new_y_max) noexcept {
+        if (new_x_min >= new_x_max or new_y_min >= new_y_max) { return Error::BadRange; }
+
+        const bool changed = new_x_min != x_min or new_x_max != x_max or new_y_min != y_min or new_y_max != y_max;
+        x_min = new_x_min;
+        x_max = new_x_max;
+        y_min = new_y_min;
+        y_max = new_y_max;
+        if (changed) { invalidate(); }
+        return changed;
+    }
+
+    /// @brief Пересчитать область данных и перерисовать слой при следующем render()
+    void invalidate() noexcept {
+        layout();
+        dirty = true;
+    }
+
+    /// @brief Наложить статический слой на область дисплея
+    /// @param x, y Левый верхний угол графика
+    /// @param op Copy - слой заменяет содержимое (вместо очистки), Or / Xor - поверх данных
+    /// @returns true, если слой был перерисован
+    bool render(const FrameView &target, Pixel x, Pixel y, FrameView::RasterOp op = FrameView::RasterOp::Copy) noexcept {
+        const bool redrawn = dirty;
+        if (dirty) {
+            drawLayer();
+            dirty = false;
+        }
+
+        if (not target.isValid()) { return redrawn; }
+
+        // Отсечение столбцов
+        const auto first = static_cast<Pixel>(std::max(0, -x));
+        const auto last = static_cast<Pixel>(std::min(static_cast<int>(W), target.width - x));
+
+        // Страница слоя ложится на две страницы области со сдвигом: маски считаются один раз на страницу
+        for (Pixel page = 0; page < pages and first < last; ++page) {
+            const auto top = static_cast<Pixel>(y + (page << 3));
+            u32 mask = page == pages - 1 ? (1u << (H - (page << 3))) - 1 : 0xFF;
+
+            // Отсечение строк
+            if (top < 0) { mask = top <= -8 ? 0 : mask & (0xFFu << -top); }
+            if (top + 8 > target.height) { mask &= top >= target.height ? 0 : (1u << (target.height - top)) - 1; }
+            if (mask == 0) { continue; }
+
+            const Pixel abs_top = target.toAbsoluteY(top);
+            const auto shift = static_cast<u8>(abs_top & 0x07);
+            const auto abs_page = static_cast<Pixel>(abs_top >> 3);
+            const auto low_mask = static_cast<u8>(mask << shift);
+            const auto high_mask = static_cast<u8>(mask << shift >> 8);
+            const u8 *source = layer_buffer + page * W;
+
+            for (Pixel column = first; column < last; ++column) {
+                const Pixel abs_x = target.toAbsoluteX(static_cast<Pixel>(x + column));
+                const u32 data = static_cast<u32>(source[column]) << shift;
+
+                if (low_mask != 0) { target.writeMaskedData(abs_x, abs_page, static_cast<u8>(data), low_mask, op); }
+                if (high_mask != 0) { target.writeMaskedData(abs_x, static_cast<Pixel>(abs_page + 1), static_cast<u8>(data >> 8), high_mask, op); }
+            }
+        }
+
+        return redrawn;
+    }
+
+    /// @brief X пикселя графика для значения (ограничивается шкалой)
+    [[nodiscard]] Pixel toX(i32 value) const noexcept {
+        return static_cast<Pixel>(plot_left + scale(value, x_min, x_max, plot_right - plot_left));
+    }
+
+    /// @brief Y пикселя графика для значения (ограничивается шкалой)
+    [[nodiscard]] Pixel toY(i32 value) const noexcept {
+        return static_cast<Pixel>(plot_bottom - scale(value, y_min, y_max, plot_bottom - plot_top));
+    }
+
+    /// @brief Нарисовать ряд ломаной: values[i] в точке X = x_min + i
+    /// @param x, y Левый верхний угол графика
+    void series(const FrameView &target, Pixel x, Pixel y, const i32 *values, u16 count, bool value_on = true) const noexcept {
+        if (count == 0) { return; }
+
+        Canvas canvas{target};
+        auto last_x = static_cast<Pixel>(x + toX(x_min));
+        auto last_y = static_cast<Pixel>(y + toY(values[0]));
+
+        for (u16 i = 1; i < count; ++i) {
+            const auto next_x = static_cast<Pixel>(x + toX(static_cast<i32>(static_cast<u32>(x_min) + i)));
+            const auto next_y = static_cast<Pixel>(y + toY(values[i]));
+            canvas.line(last_x, last_y, next_x, next_y, value_on);
+            last_x = next_x;
+            last_y = next_y;
+        }
+
+        if (count == 1) { canvas.dot(last_x, last_y, value_on); }
+    }
+
+private:
+    Chart(i32 x_min, i32 x_max, i32 y_min, i32 y_max, const Font *font) noexcept :
+        x_min{x_min}, x_max{x_max}, y_min{y_min}, y_max{y_max}, font{font} { layout(); }
+
+    /// @brief Отображение [min, max] на [0, span] с округлением
+    [[nodiscard]] static i32 scale(i32 value, i32 min, i32 max, i32 span) noexcept {
+        value = std::min(std::max(value, min), max);
+        const auto offset = static_cast<u32>(value) - static_cast<u32>(min);
+        const auto range = static_cast<u32>(max) - static_cast<u32>(min);
+        return static_cast<i32>((static_cast<u64>(offset) * static_cast<u32>(span) + range / 2) / range);
+    }
+
+    /// @brief Значение деления index из count
+    [[nodiscard]] static i32 tickValue(i32 min, i32 max, u8 index, u8 count) noexcept {
+        const auto range = static_cast<u32>(max) - static_cast<u32>(min);
+        return static_cast<i32>(static_cast<u32>(min) + static_cast<u32>(static_cast<u64>(range) * index / count));
+    }
+
+    /// @brief Десятичная запись числа
+    /// @returns Длина
+    static u8 format(i32 value, char *out) noexcept {
+        char digits[label_capacity];
+        u8 count = 0;
+        auto magnitude = value < 0 ? 0u - static_cast<u32>(value) : static_cast<u32>(value);
+
+        do {
+            digits[count++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+
+        u8 length = 0;
+        if (value < 0) { out[length++] = '-'; }
+        while (count != 0) { out[length++] = digits[--count]; }
+        out[length] = '\0';
+        return length;
+    }
+
+    /// @brief Рассчитать область данных по подписям
+    void layout() noexcept {
+        plot_left = tick_length;
+        plot_top = 0;
+        plot_right = W - 1;
+        plot_bottom = static_cast<Pixel>(H - 1 - tick_length);
+
+        if (nullptr == font) { return; }
+
+        char label[label_capacity];
+        u8 widest = 0;
+        for (u8 i = 0; i <= y_ticks; ++i) {
+            widest = std::max(widest, format(tickValue(y_min, y_max, i, std::max(y_ticks, u8{1})), label));
+        }
+
+        const u8 last_x_label = format(x_max, label);
+
+        plot_left = static_cast<Pixel>(widest * font->widthTotal() + tick_length + 1);
+        plot_top = static_cast<Pixel>(font->glyph_height / 2);
+        plot_right = static_cast<Pixel>(W - 1 - last_x_label * font->widthTotal() / 2);
+        plot_bottom = static_cast<Pixel>(H - 1 - tick_length - 1 - font->heightTotal());
+    }
+
+    /// @brief Нарисовать подпись, ограниченную графиком
+    void drawLabel(Canvas &canvas, Pixel x, Pixel y, const char *label, u8 length) const noexcept {
+        const auto width = static_cast<Pixel>(length * font->widthTotal());
+        canvas.setCursor(
+            std::min(std::max(x, static_cast<Pixel>(0)), static_cast<Pixel>(W - width)),
+            std::min(std::max(y, static_cast<Pixel>(0)), static_cast<Pixel>(H - font->heightTotal())));
+        canvas.text(label, on);
+    }
+
+    /// @brief Нарисовать статический слой: сетка, деления, подписи, оси
+    void drawLayer() noexcept {
+        Canvas canvas{FrameView{layer_buffer, W, W, H, 0, 0}, nullptr == font ? Font::blank() : *font};
+        canvas.fill(not on);
+
+        char label[label_capacity];
+
+        for (u8 i = 0; i <= x_ticks and x_ticks != 0; ++i) {
+            const i32 value = tickValue(x_min, x_max, i, x_ticks);
+            const Pixel px = toX(value);
+
+            if (show_grid and i != 0) { canvas.line(px, plot_top, px, static_cast<Pixel>(plot_bottom - 1), grid, on); }
+            canvas.line(px, static_cast<Pixel>(plot_bottom + 1), px, static_cast<Pixel>(plot_bottom + tick_length), on);
+
+            if (nullptr != font) {
+                const u8 length = format(value, label);
+                drawLabel(canvas, static_cast<Pixel>(px - length * font->widthTotal() / 2), static_cast<Pixel>(plot_bottom + tick_length + 2), label, length);
+            }
+        }
+
+        for (u8 i = 0; i <= y_ticks and y_ticks != 0; ++i) {
+            const i32 value = tickValue(y_min, y_max, i, y_ticks);
+            const Pixel py = toY(value);
+
+            if (show_grid and i != 0) { canvas.line(static_cast<Pixel>(plot_left + 1), py, plot_right, py, grid, on); }
+            canvas.line(static_cast<Pixel>(plot_left - tick_length), py, static_cast<Pixel>(plot_left - 1), py, on);
+
+            if (nullptr != font) {
+                const u8 length = format(value, label);
+                drawLabel(canvas, static_cast<Pixel>(plot_left - tick_length - 1 - length * font->widthTotal()), static_cast<Pixel>(py - font->glyph_height / 2), label, length);
+            }
+        }
+
+        canvas.line(plot_left, plot_top, plot_left, plot_bottom, on);
+        canvas.line(plot_left, plot_bottom, plot_right, plot_bottom, on);
+    }
+};
+
+}// namespace kf::gfx
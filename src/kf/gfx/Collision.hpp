@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+
+#include <kf/units.hpp>
+
+#include "kf/gfx/BitMap.hpp"
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Попиксельная проверка столкновений битмапов
+/// @details Сначала пересекаются ограничивающие прямоугольники, затем внутри пересечения
+/// байты страниц одного битмапа сравниваются через AND со сдвинутыми столбцами другого.
+/// Проверка завершается на первом совпавшем байте
+namespace collision {
+
+/// @brief Прямоугольник пересечения
+struct Box final {
+
+    /// @brief Левая граница
+    Pixel left;
+
+    /// @brief Верхняя граница
+    Pixel top;
+
+    /// @brief Правая граница (не включая)
+    Pixel right;
+
+    /// @brief Нижняя граница (не включая)
+    Pixel bottom;
+
+    /// @brief Прямоугольник пуст
+    [[nodiscard]] inline bool empty() const noexcept { return left >= right or top >= bottom; }
+};
+
+/// @brief Пересечение ограничивающих прямоугольников
+[[nodiscard]] inline Box intersect(
+    Pixel ax, Pixel ay, Pixel a_width, Pixel a_height,
+    Pixel bx, Pixel by, Pixel b_width, Pixel b_height) noexcept {
+    return Box{
+        std::max(ax, bx),
+        std::max(ay, by),
+        static_cast<Pixel>(std::min(ax + a_width, bx + b_width)),
+        static_cast<Pixel>(std::min(ay + a_height, by + b_height)),
+    };
+}
+
+/// @brief 8 строк столбца битмапа начиная со строки row
+/// @returns Бит 0 соответствует строке row, строки вне битмапа - 0
+[[nodiscard]] inline u8 columnBits(const BitMapView &bitmap, Pixel x, Pixel row) noexcept {
+    if (row <= -8 or row >= bitmap.height) { return 0; }
+
+    const auto page = static_cast<Pixel>(row >> 3);
+    const auto shift = static_cast<u8>(row & 0x07);
+
+    u16 bits = 0;
+    if (page >= 0) { bits = bitmap.buffer[page * bitmap.width + x]; }
+    if (shift != 0 and page + 1 < bitmap.pages()) {
+        bits |= static_cast<u16>(bitmap.buffer[(page + 1) * bitmap.width + x] << 8);
+    }
+
+    bits >>= shift;
+
+    // Строки за пределами высоты битмапа не относятся к изображению
+    const auto rows = static_cast<Pixel>(bitmap.height - row);
+    if (rows < 8) { bits &= static_cast<u16>((1u << rows) - 1); }
+
+    return static_cast<u8>(bits);
+}
+
+/// @brief Пересекаются ли включённые пиксели двух битмапов
+/// @param ax, ay Позиция битмапа a
+/// @param bx, by Позиция битмапа b
+[[nodiscard]] inline bool overlap(
+    const BitMapView &a, Pixel ax, Pixel ay,
+    const BitMapView &b, Pixel bx, Pixel by) noexcept {
+    const Box box = intersect(ax, ay, a.width, a.height, bx, by, b.width, b.height);
+    if (box.empty()) { return false; }
+
+    // Строки пересечения в координатах a, по страницам a
+    const auto first_row = static_cast<Pixel>(box.top - ay);
+    const auto last_row = static_cast<Pixel>(box.bottom - ay - 1);
+    const auto first_page = static_cast<Pixel>(first_row >> 3);
+    const auto last_page = static_cast<Pixel>(last_row >> 3);
+
+    for (Pixel page = first_page; page <= last_page; ++page) {
+        const auto page_row = static_cast<Pixel>(page << 3);
+        const u8 rows = FrameView::createPageMask(
+            static_cast<u8>(std::max(first_row - page_row, 0)),
+            static_cast<u8>(std::min(last_row - page_row, 7)));
+
+        // Строка b, совпадающая с первой строкой страницы a
+        const auto b_row = static_cast<Pixel>(ay + page_row - by);
+        const u8 *a_page = a.buffer + page * a.width;
+
+        for (Pixel x = box.left; x < box.right; ++x) {
+            const u8 a_bits = a_page[x - ax] & rows;
+            if (a_bits == 0) { continue; }
+
+            if (a_bits & columnBits(b, static_cast<Pixel>(x - bx), b_row)) { return true; }
+        }
+    }
+
+    return false;
+}
+
+/// @brief Пересекаются ли включённые пиксели битмапа с включёнными пикселями области
+/// @param x, y Позиция битмапа в области
+[[nodiscard]] inline bool overlap(const BitMapView &sprite, Pixel x, Pixel y, const FrameView &frame) noexcept {
+    if (not frame.isValid()) { return false; }
+
+    const Box box = intersect(x, y, sprite.width, sprite.height, 0, 0, frame.width, frame.height);
+    if (box.empty()) { return false; }
+
+    const auto first_row = static_cast<Pixel>(box.top - y);
+    const auto last_row = static_cast<Pixel>(box.bottom - y - 1);
+    const auto first_page = static_cast<Pixel>(first_row >> 3);
+    const auto last_page = static_cast<Pixel>(last_row >> 3);
+
+    for (Pixel page = first_page; page <= last_page; ++page) {
+        const auto page_row = static_cast<Pixel>(page << 3);
+        const u8 rows = FrameView::createPageMask(
+            static_cast<u8>(std::max(first_row - page_row, 0)),
+            static_cast<u8>(std::min(last_row - page_row, 7)));
+
+        // Страница спрайта ложится на одну или две страницы дисплея
+        const auto abs_row = frame.toAbsoluteY(static_cast<Pixel>(y + page_row));
+        const auto frame_page = static_cast<Pixel>(abs_row >> 3);
+        const auto shift = static_cast<u8>(abs_row & 0x07);
+        const u8 *sprite_page = sprite.buffer + page * sprite.width;
+
+        for (Pixel column = static_cast<Pixel>(box.left - x); column < box.right - x; ++column) {
+            const u8 bits = sprite_page[column] & rows;
+            if (bits == 0) { continue; }
+
+            // Страница дисплея читается, только если на неё попадают строки пересечения
+            const Pixel abs_x = frame.toAbsoluteX(static_cast<Pixel>(x + column));
+            const auto upper = static_cast<u8>(bits << shift);
+            const auto lower = static_cast<u8>(shift == 0 ? 0 : bits >> (8 - shift));
+
+            if (upper != 0 and (upper & frame.readData(abs_x, frame_page))) { return true; }
+            if (lower != 0 and (lower & frame.readData(abs_x, static_cast<Pixel>(frame_page + 1)))) { return true; }
+        }
+    }
+
+    return false;
+}
+
+}// namespace collision
+}// namespace kf::gfx
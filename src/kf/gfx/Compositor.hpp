@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/BitMap.hpp"
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Компоновщик спрайтов поверх статического фона
+/// @details Фон хранится в отдельном буфере. Дисплей разбит на плитки 8x8 (8 столбцов одной страницы).
+/// При перемещении спрайта помечаются плитки старых и новых границ, и compose()
+/// пересобирает только помеченные плитки: фон, затем спрайты в порядке z
+/// @tparam W Ширина дисплея
+/// @tparam H Высота дисплея
+/// @tparam MaxSprites Максимальное количество спрайтов
+template<Pixel W, Pixel H, u8 MaxSprites> struct Compositor final {
+
+    /// @brief Количество страниц
+    static constexpr Pixel pages = (H + 7) / 8;
+
+    /// @brief Количество плиток по горизонтали
+    static constexpr Pixel tiles_x = (W + 7) / 8;
+
+    /// @brief Количество плиток
+    static constexpr usize tiles_count = tiles_x * pages;
+
+    /// @brief Ошибки
+    enum class Error : u8 {
+
+        /// @brief Все слоты спрайтов заняты
+        TooManySprites,
+
+        /// @brief Пустое изображение или маска другого размера
+        BadImage,
+    };
+
+    /// @brief Идентификатор спрайта
+    using SpriteId = u8;
+
+private:
+    /// @brief Спрайт
+    struct Sprite final {
+
+        /// @brief Изображение
+        BitMapView image;
+
+        /// @brief Маска непрозрачности (buffer == nullptr - без маски, изображение накладывается через OR)
+        BitMapView mask;
+
+        /// @brief Позиция X
+        Pixel x;
+
+        /// @brief Позиция Y
+        Pixel y;
+
+        /// @brief Порядок наложения (больше - выше)
+        u8 z;
+
+        /// @brief Видимость
+        bool visible;
+    };
+
+    /// @brief Буфер фона
+    u8 background_buffer[W * pages]{};
+
+    /// @brief Спрайты
+    Sprite sprites[MaxSprites]{};
+
+    /// @brief Идентификаторы спрайтов в порядке z
+    SpriteId order[MaxSprites]{};
+
+    /// @brief Помеченные плитки
+    u8 dirty[(tiles_count + 7) / 8]{};
+
+    /// @brief Количество спрайтов
+    u8 count{0};
+
+public:
+    /// @brief Область фона для рисования через Canvas
+    /// @details После изменения фона область нужно пометить (invalidate)
+    [[nodiscard]] FrameView background() noexcept {
+        return FrameView{background_buffer, W, W, H, 0, 0};
+    }
+
+    /// @brief Количество спрайтов
+    [[nodiscard]] inline u8 spritesCount() const noexcept { return count; }
+
+    /// @brief Добавить спрайт
+    /// @param mask Маска непрозрачности того же размера или пустая
+    [[nodiscard]] Result<SpriteId, Error> add(
+        const BitMapView &image,
+        const BitMapView &mask,
+        Pixel x,
+        Pixel y,
+        u8 z = 0) noexcept {
+        if (count >= MaxSprites) { return Error::TooManySprites; }
+        if (not validImage(image, mask)) { return Error::BadImage; }
+
+        const SpriteId id = count;
+        sprites[id] = Sprite{image, mask, x, y, z, true};
+        order[count] = id;
+        count += 1;
+
+        sortOrder();
+        invalidateSprite(id);
+        return id;
+    }
+
+    /// @brief Переместить спрайт
+    /// @details Неизвестный id игнорируется
+    void move(SpriteId id, Pixel x, Pixel y) noexcept {
+        if (id >= count) { return; }
+
+        Sprite &sprite = sprites[id];
+        if (sprite.x == x and sprite.y == y) { return; }
+
+        invalidateSprite(id);
+        sprite.x = x;
+        sprite.y = y;
+        invalidateSprite(id);
+    }
+
+    /// @brief Сменить изображение спрайта (кадр анимации)
+    /// @returns false, если id неизвестен или изображение неверное
+    bool setImage(SpriteId id, const BitMapView &image, const BitMapView &mask) noexcept {
+        if (id >= count or not validImage(image, mask)) { return false; }
+
+        invalidateSprite(id);
+        sprites[id].image = image;
+        sprites[id].mask = mask;
+        invalidateSprite(id);
+        return true;
+    }
+
+    /// @brief Показать или скрыть спрайт
+    /// @details Неизвестный id игнорируется
+    void setVisible(SpriteId id, bool visible) noexcept {
+        if (id >= count or sprites[id].visible == visible) { return; }
+
+        sprites[id].visible = true;
+        invalidateSprite(id);
+        sprites[id].visible = visible;
+    }
+
+    /// @brief Изменить порядок наложения
+    /// @details Неизвестный id игнорируется
+    void setZ(SpriteId id, u8 z) noexcept {
+        if (id >= count or sprites[id].z == z) { return; }
+
+        sprites[id].z = z;
+        sortOrder();
+        invalidateSprite(id);
+    }
+
+    /// @brief Пометить область для пересборки
+    void invalidate(Pixel x, Pixel y, Pixel width, Pixel height) noexcept {
+        const Pixel x0 = std::max(x, static_cast<Pixel>(0));
+        const Pixel y0 = std::max(y, static_cast<Pixel>(0));
+        const auto x1 = static_cast<Pixel>(std::min(x + width, static_cast<int>(W)) - 1);
+        const auto y1 = static_cast<Pixel>(std::min(y + height, static_cast<int>(H)) - 1);
+        if (x0 > x1 or y0 > y1) { return; }
+
+        for (Pixel page = static_cast<Pixel>(y0 >> 3); page <= y1 >> 3; ++page) {
+            for (Pixel tile = static_cast<Pixel>(x0 >> 3); tile <= x1 >> 3; ++tile) {
+                const usize index = page * tiles_x + tile;
+                dirty[index >> 3] |= static_cast<u8>(1 << (index & 7));
+            }
+        }
+    }
+
+    /// @brief Пометить весь дисплей
+    void invalidateAll() noexcept { std::memset(dirty, 0xFF, sizeof(dirty)); }
+
+    /// @brief Пересобрать помеченные плитки
+    /// @param target Область дисплея W x H
+    /// @returns Количество пересобранных плиток
+    usize compose(const FrameView &target) noexcept {
+        usize composed = 0;
+
+        for (usize index = 0; index < tiles_count; ++index) {
+            if ((dirty[index >> 3] & (1 << (index & 7))) == 0) { continue; }
+
+            composeTile(
+                target,
+                static_cast<Pixel>((index % tiles_x) << 3),
+                static_cast<Pixel>(index / tiles_x));
+            composed += 1;
+        }
+
+        std::memset(dirty, 0, sizeof(dirty));
+        return composed;
+    }
+
+private:
+    [[nodiscard]] static bool validImage(const BitMapView &image, const BitMapView &mask) noexcept {
+        if (nullptr == image.buffer or image.width < 1 or image.height < 1) { return false; }
+        if (nullptr == mask.buffer) { return true; }
+        return mask.width == image.width and mask.height == image.height;
+    }
+
+    /// @brief Упорядочить спрайты по z, при равном z - в порядке добавления (вставками, спрайтов немного)
+    void sortOrder() noexcept {
+        const auto above = [this](SpriteId a, SpriteId b) {
+            return sprites[a].z > sprites[b].z or (sprites[a].z == sprites[b].z and a > b);
+        };
+
+        for (u8 i = 1; i < count; ++i) {
+            const SpriteId id = order[i];
+            u8 j = i;
+
+            while (j > 0 and above(order[j - 1], id)) {
+                order[j] = order[j - 1];
+                j -= 1;
+            }
+
+            order[j] = id;
+        }
+    }
+
+    void invalidateSprite(SpriteId id) noexcept {
+        const Sprite &sprite = sprites[id];
+        if (not sprite.visible) { return; }
+        invalidate(sprite.x, sprite.y, sprite.image.width, sprite.image.height);
+    }
+
+    /// @brief Собрать плитку: фон и пересекающие её спрайты
+    void composeTile(const FrameView &target, Pixel tile_x, Pixel page) const noexcept {
+        const auto tile_y = static_cast<Pixel>(page << 3);
+        const auto tile_width = static_cast<Pixel>(std::min(8, W - tile_x));
+        const auto tile_height = static_cast<Pixel>(std::min(8, H - tile_y));
+
+        FrameView tile{target};
+        tile.offset_x = static_cast<Pixel>(tile.offset_x + tile_x);
+        tile.offset_y = static_cast<Pixel>(tile.offset_y + tile_y);
+        tile.width = tile_width;
+        tile.height = tile_height;
+
+        const u8 *source = background_buffer + page * W + tile_x;
+        for (Pixel x = 0; x < tile_width; ++x) {
+            tile.writeColumn(x, 0, source[x], 0xFF);
+        }
+
+        for (u8 i = 0; i < count; ++i) {
+            const Sprite &sprite = sprites[order[i]];
+            if (not sprite.visible) { continue; }
+
+            if (sprite.x >= tile_x + tile_width or sprite.x + sprite.image.width <= tile_x or
+                sprite.y >= tile_y + tile_height or sprite.y + sprite.image.height <= tile_y) {
+                continue;
+            }
+
+            blitSprite(tile, sprite, static_cast<Pixel>(sprite.x - tile_x), static_cast<Pixel>(sprite.y - tile_y));
+        }
+    }
+
+    /// @brief Наложить часть спрайта, попадающую в плитку
+    static void blitSprite(const FrameView &tile, const Sprite &sprite, Pixel x, Pixel y) noexcept {
+        const BitMapView &image = sprite.image;
+        const bool masked = nullptr != sprite.mask.buffer;
+
+        const auto column_begin = static_cast<Pixel>(std::max(0, -x));
+        const auto column_end = static_cast<Pixel>(std::min(static_cast<int>(image.width), tile.width - x));
+
+        // Страницы спрайта, пересекающие плитку
+        const auto page_begin = static_cast<Pixel>(std::max(0, -y) >> 3);
+        const auto page_end = static_cast<Pixel>(std::min(
+            static_cast<int>(image.pages()),
+            ((tile.height - y) + 7) >> 3));
+
+        for (Pixel page = page_begin; page < page_end; ++page) {
+            u8 height_mask = 0xFF;
+            if (page == image.pages() - 1) {
+                height_mask = FrameView::createPageMask(0, static_cast<u8>((image.height - 1) & 0x07));
+            }
+
+            const u8 *bits = image.buffer + page * image.width;
+            const u8 *mask = masked ? sprite.mask.buffer + page * image.width : bits;
+            const auto row = static_cast<Pixel>(y + (page << 3));
+
+            for (Pixel column = column_begin; column < column_end; ++column) {
+                const auto m = static_cast<u8>(mask[column] & height_mask);
+                if (m == 0) { continue; }
+
+                tile.writeColumn(
+                    static_cast<Pixel>(x + column),
+                    row,
+                    bits[column],
+                    m,
+                    masked ? FrameView::RasterOp::Copy : FrameView::RasterOp::Or);
+            }
+        }
+    }
+};
+
+}// namespace kf::gfx
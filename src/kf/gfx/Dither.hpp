@@ -0,0 +1,207 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include <kf/units.hpp>
+
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Преобразование полутоновых изображений (8 бит, построчно) в область дисплея
+/// @details Пиксель включается, если яркость выше порога.
+/// Изображение обрабатывается полосами по 8 строк: байт страницы собирается
+/// из 8 строк в буфере полосы и записывается один раз
+namespace dither {
+
+/// @brief Полутоновое изображение
+struct GrayImage final {
+
+    /// @brief Яркости построчно (0 - чёрный, 255 - белый)
+    const u8 *pixels;
+
+    /// @brief Ширина
+    Pixel width;
+
+    /// @brief Высота
+    Pixel height;
+
+    /// @brief Шаг строки в байтах
+    usize stride;
+
+    /// @brief Строка изображения
+    [[nodiscard]] inline const u8 *row(Pixel y) const noexcept { return pixels + y * stride; }
+};
+
+/// @brief Ширина блока столбцов полосы
+static constexpr Pixel block_width = 64;
+
+/// @brief Матрица Байера 8x8 (0..63)
+static constexpr u8 bayer[8][8] = {
+    {0, 32, 8, 40, 2, 34, 10, 42},
+    {48, 16, 56, 24, 50, 18, 58, 26},
+    {12, 44, 4, 36, 14, 46, 6, 38},
+    {60, 28, 52, 20, 62, 30, 54, 22},
+    {3, 35, 11, 43, 1, 33, 9, 41},
+    {51, 19, 59, 27, 49, 17, 57, 25},
+    {15, 47, 7, 39, 13, 45, 5, 37},
+    {63, 31, 55, 23, 61, 29, 53, 21},
+};
+
+/// @brief Пороговое преобразование строк [y0, y0 + rows) блока столбцов в буфер полосы
+/// @param x0 Первый столбец блока (кратен 8)
+/// @param thresholds Пороги строки: <code>const u8 *(Pixel row)</code>, 8 значений, повторяются по X
+template<typename Thresholds> inline void thresholdStrip(
+    const GrayImage &image,
+    Pixel x0,
+    Pixel y0,
+    Pixel width,
+    Pixel rows,
+    Thresholds &&thresholds,
+    u8 *strip) noexcept {
+    std::memset(strip, 0, width);
+    u8 row_thresholds[block_width];
+
+    for (Pixel r = 0; r < rows; ++r) {
+        const u8 *source = image.row(static_cast<Pixel>(y0 + r)) + x0;
+        const u8 *threshold = thresholds(static_cast<Pixel>(y0 + r));
+
+        for (usize i = 0; i < static_cast<usize>(width); ++i) { row_thresholds[i] = threshold[i & 7]; }
+
+        // Сравнения без ветвлений: цикл векторизуется компилятором
+        const auto bit = static_cast<u8>(1 << r);
+        for (usize i = 0; i < static_cast<usize>(width); ++i) {
+            strip[i] |= static_cast<u8>(source[i] > row_thresholds[i] ? bit : 0);
+        }
+    }
+}
+
+/// @brief Пороговое преобразование без размытия
+/// @param x, y Позиция изображения в области
+inline void threshold(const FrameView &target, Pixel x, Pixel y, const GrayImage &image, u8 level = 127) noexcept {
+    u8 levels[8];
+    std::memset(levels, level, sizeof(levels));
+
+    u8 strip[block_width];
+
+    for (Pixel y0 = 0; y0 < image.height; y0 = static_cast<Pixel>(y0 + 8)) {
+        const auto rows = static_cast<Pixel>(std::min(8, image.height - y0));
+
+        for (Pixel x0 = 0; x0 < image.width; x0 = static_cast<Pixel>(x0 + block_width)) {
+            const auto width = static_cast<Pixel>(std::min(static_cast<int>(block_width), image.width - x0));
+
+            thresholdStrip(image, x0, y0, width, rows, [&levels](Pixel) { return levels; }, strip);
+            target.writeStrip(static_cast<Pixel>(x + x0), static_cast<Pixel>(y + y0), strip, width, rows);
+        }
+    }
+}
+
+/// @brief Упорядоченное размытие матрицей Байера 8x8
+/// @param x, y Позиция изображения в области
+inline void ordered(const FrameView &target, Pixel x, Pixel y, const GrayImage &image) noexcept {
+    // Пороги 2..254 с шагом 4
+    u8 thresholds[8][8];
+    for (u8 r = 0; r < 8; ++r) {
+        for (u8 c = 0; c < 8; ++c) { thresholds[r][c] = static_cast<u8>(bayer[r][c] * 4 + 2); }
+    }
+
+    u8 strip[block_width];
+
+    for (Pixel y0 = 0; y0 < image.height; y0 = static_cast<Pixel>(y0 + 8)) {
+        const auto rows = static_cast<Pixel>(std::min(8, image.height - y0));
+
+        for (Pixel x0 = 0; x0 < image.width; x0 = static_cast<Pixel>(x0 + block_width)) {
+            const auto width = static_cast<Pixel>(std::min(static_cast<int>(block_width), image.width - x0));
+
+            thresholdStrip(image, x0, y0, width, rows, [&thresholds](Pixel row) { return thresholds[row & 7]; }, strip);
+            target.writeStrip(static_cast<Pixel>(x + x0), static_cast<Pixel>(y + y0), strip, width, rows);
+        }
+    }
+}
+
+/// @brief Размытие с диффузией ошибки (Флойд-Стейнберг, Аткинсон)
+/// @details Хранит ошибки трёх строк и полосу выходных байт
+/// @tparam MaxWidth Максимальная ширина изображения (столбцы за ней отбрасываются)
+template<Pixel MaxWidth> struct ErrorDiffusion final {
+
+    /// @brief Отступ буфера ошибок по краям строки
+    static constexpr Pixel padding = 2;
+
+private:
+    /// @brief Ошибки строк (кольцо из трёх)
+    i16 errors[3][MaxWidth + 2 * padding]{};
+
+    /// @brief Полоса выходных байт
+    u8 strip[MaxWidth]{};
+
+public:
+    /// @brief Флойд-Стейнберг: 7/16 вправо, 3/16, 5/16, 1/16 в следующую строку
+    /// @param x, y Позиция изображения в области
+    void floydSteinberg(const FrameView &target, Pixel x, Pixel y, const GrayImage &image) noexcept {
+        run(target, x, y, image, [](i16 *current, i16 *next, i16 *, Pixel i, int error) {
+            current[i + 1] = static_cast<i16>(current[i + 1] + error * 7 / 16);
+            next[i - 1] = static_cast<i16>(next[i - 1] + error * 3 / 16);
+            next[i] = static_cast<i16>(next[i] + error * 5 / 16);
+            next[i + 1] = static_cast<i16>(next[i + 1] + error / 16);
+        });
+    }
+
+    /// @brief Аткинсон: по 1/8 ошибки шести соседям, 1/4 ошибки теряется (контрастнее на 1-битных дисплеях)
+    /// @param x, y Позиция изображения в области
+    void atkinson(const FrameView &target, Pixel x, Pixel y, const GrayImage &image) noexcept {
+        run(target, x, y, image, [](i16 *current, i16 *next, i16 *after_next, Pixel i, int error) {
+            const auto part = static_cast<i16>(error / 8);
+            current[i + 1] = static_cast<i16>(current[i + 1] + part);
+            current[i + 2] = static_cast<i16>(current[i + 2] + part);
+            next[i - 1] = static_cast<i16>(next[i - 1] + part);
+            next[i] = static_cast<i16>(next[i] + part);
+            next[i + 1] = static_cast<i16>(next[i + 1] + part);
+            after_next[i] = static_cast<i16>(after_next[i] + part);
+        });
+    }
+
+private:
+    /// @brief Проход по строкам с распределением ошибки
+    /// @param diffuse <code>void(i16 *current, i16 *next, i16 *after_next, Pixel i, int error)</code>
+    template<typename Diffuse> void run(
+        const FrameView &target,
+        Pixel x,
+        Pixel y,
+        const GrayImage &image,
+        Diffuse &&diffuse) noexcept {
+        const auto width = static_cast<Pixel>(std::min(image.width, MaxWidth));
+        std::memset(errors, 0, sizeof(errors));
+
+        for (Pixel y0 = 0; y0 < image.height; y0 = static_cast<Pixel>(y0 + 8)) {
+            const auto rows = static_cast<Pixel>(std::min(8, image.height - y0));
+            std::memset(strip, 0, width);
+
+            for (Pixel r = 0; r < rows; ++r) {
+                const auto row = static_cast<Pixel>(y0 + r);
+                const u8 *source = image.row(row);
+
+                i16 *current = errors[row % 3] + padding;
+                i16 *next = errors[(row + 1) % 3] + padding;
+                i16 *after_next = errors[(row + 2) % 3] + padding;
+
+                for (Pixel i = 0; i < width; ++i) {
+                    const int value = source[i] + current[i];
+                    const bool on = value > 127;
+
+                    strip[i] |= static_cast<u8>(on << r);
+                    diffuse(current, next, after_next, i, value - (on ? 255 : 0));
+                }
+
+                // Строка освобождается для row + 3
+                std::memset(errors[row % 3], 0, sizeof(errors[0]));
+            }
+
+            target.writeStrip(x, static_cast<Pixel>(y + y0), strip, width, rows);
+        }
+    }
+};
+
+}// namespace dither
+}// namespace kf::gfx
@@ -0,0 +1,366 @@
+#pragma once
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/BitMap.hpp"
+#include "kf/gfx/Canvas.hpp"
+#include "kf/gfx/DrawLog.hpp"
+#include "kf/gfx/Font.hpp"
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Потоковый исполнитель команд draw_log
+/// @details Принимает поток по байту и выполняет команду сразу после получения её аргументов.
+/// Текст выводится по мере поступления символов. Память не выделяется.
+/// @details Поток начинается с заголовка draw_log. Заголовок, полученный между командами,
+/// начинает новый сеанс, что позволяет восстановить синхронизацию после ошибки.
+struct DrawInterpreter final {
+
+    /// @brief Ошибки исполнения
+    enum class Error : u8 {
+
+        /// @brief Неверная сигнатура заголовка или команда до заголовка
+        BadHeader,
+
+        /// @brief Неподдерживаемая версия формата
+        UnsupportedVersion,
+
+        /// @brief Дисплей отправителя больше целевого
+        DisplayMismatch,
+
+        /// @brief Неизвестный код операции
+        UnknownOp,
+
+        /// @brief Область выходит за границы дисплея
+        FrameOutOfBounds,
+
+        /// @brief Хеш кадра не совпал с переданным
+        HashMismatch,
+    };
+
+private:
+    /// @brief Состояние разбора
+    enum class State : u8 {
+
+        /// @brief Ожидание заголовка (после создания или ошибки)
+        WaitHeader,
+
+        /// @brief Приём заголовка
+        Header,
+
+        /// @brief Ожидание кода операции
+        Opcode,
+
+        /// @brief Приём аргументов
+        Args,
+
+        /// @brief Приём символов текста
+        TextChars,
+    };
+
+    /// @brief Максимальный размер аргументов операции
+    static constexpr usize max_args_size = 15;
+
+    /// @brief Буфер дисплея
+    u8 *frame_buffer;
+
+    /// @brief Размер буфера дисплея
+    usize frame_size;
+
+    /// @brief Целевой дисплей
+    FrameView root;
+
+    /// @brief Текущая область рисования
+    Canvas canvas;
+
+    /// @brief Таблица шрифтов
+    const Font *const *fonts;
+
+    /// @brief Таблица битмапов
+    const BitMapView *bitmaps;
+
+    /// @brief Количество шрифтов
+    u8 fonts_count;
+
+    /// @brief Количество битмапов
+    u8 bitmaps_count;
+
+    /// @brief Состояние разбора
+    State state{State::WaitHeader};
+
+    /// @brief Текущая операция
+    draw_log::Op op{draw_log::Op::Frame};
+
+    /// @brief Аргументы текущей операции
+    u8 args[max_args_size]{};
+
+    /// @brief Принято байт аргументов (или заголовка)
+    u8 received{0};
+
+    /// @brief Цвет текста текущей команды Text
+    bool text_on{true};
+
+    /// @brief Вывод текущей строки прекращён
+    bool text_stopped{false};
+
+public:
+    /// @brief Создать исполнитель для дисплея
+    [[nodiscard]] static Result<DrawInterpreter, FrameView::Error> create(
+        /// @brief Буфер дисплея: width * ((height + 7) / 8) байт
+        u8 *frame_buffer,
+
+        /// @brief Ширина дисплея
+        Pixel width,
+
+        /// @brief Высота дисплея
+        Pixel height,
+
+        /// @brief Таблица шрифтов (id = индекс)
+        const Font *const *fonts = nullptr,
+
+        /// @brief Количество шрифтов
+        u8 fonts_count = 0,
+
+        /// @brief Таблица битмапов (id = индекс)
+        const BitMapView *bitmaps = nullptr,
+
+        /// @brief Количество битмапов
+        u8 bitmaps_count = 0) noexcept {
+        const auto root_result = FrameView::create(frame_buffer, width, width, height, 0, 0);
+        if (not root_result.isOk()) { return root_result.error().value(); }
+
+        return DrawInterpreter{
+            frame_buffer,
+            static_cast<usize>(width) * ((height + 7) / 8),
+            root_result.ok().value(),
+            fonts,
+            fonts_count,
+            bitmaps,
+            bitmaps_count};
+    }
+
+    /// @brief Последняя выполненная операция
+    [[nodiscard]] inline draw_log::Op lastOp() const noexcept { return op; }
+
+    /// @brief Ожидается начало команды (поток не обрывается посреди записи)
+    [[nodiscard]] inline bool idle() const noexcept { return state == State::Opcode; }
+
+    /// @brief Принять байт потока
+    /// @returns true, если команда выполнена полностью (см. lastOp)
+    /// @details После ошибки байты пропускаются до следующего заголовка
+    Result<bool, Error> feed(u8 byte) noexcept {
+        switch (state) {
+            case State::WaitHeader:
+                if (byte == draw_log::magic[0]) {
+                    state = State::Header;
+                    received = 1;
+                }
+                return false;
+
+            case State::Header:
+                return feedHeader(byte);
+
+            case State::Opcode:
+                if (byte == draw_log::magic[0]) {
+                    state = State::Header;
+                    received = 1;
+                    return false;
+                }
+
+                op = static_cast<draw_log::Op>(byte);
+                if (draw_log::argsSize(op) == 0) { return fail(Error::UnknownOp); }
+
+                state = State::Args;
+                received = 0;
+                return false;
+
+            case State::Args:
+                args[received] = byte;
+                received += 1;
+
+                if (received < draw_log::argsSize(op)) { return false; }
+
+                state = State::Opcode;
+                return execute();
+
+            case State::TextChars:
+                if (byte == '\0') {
+                    state = State::Opcode;
+                    return true;
+                }
+
+                if (not text_stopped) {
+                    text_stopped = not canvas.drawChar(static_cast<char>(byte), text_on);
+                }
+                return false;
+        }
+
+        return false;
+    }
+
+    /// @brief Принять блок потока
+    /// @returns Количество полностью выполненных команд
+    Result<usize, Error> feed(const u8 *data, usize size) noexcept {
+        usize completed = 0;
+
+        for (usize i = 0; i < size; ++i) {
+            const auto result = feed(data[i]);
+            if (not result.isOk()) { return result.error().value(); }
+            if (result.ok().value()) { completed += 1; }
+        }
+
+        return completed;
+    }
+
+private:
+    /// @brief Перейти в ожидание заголовка
+    Result<bool, Error> fail(Error error) noexcept {
+        state = State::WaitHeader;
+        return error;
+    }
+
+    /// @brief Принять байт заголовка
+    Result<bool, Error> feedHeader(u8 byte) noexcept {
+        if (received < sizeof(draw_log::magic)) {
+            if (byte != draw_log::magic[received]) { return fail(Error::BadHeader); }
+        } else if (received == sizeof(draw_log::magic)) {
+            if (byte != draw_log::version) { return fail(Error::UnsupportedVersion); }
+        } else {
+            args[received - sizeof(draw_log::magic) - 1] = byte;
+        }
+
+        received += 1;
+        if (received < draw_log::header_size) { return false; }
+
+        if (draw_log::readPixel(args) > root.width or draw_log::readPixel(args + 2) > root.height) {
+            return fail(Error::DisplayMismatch);
+        }
+
+        canvas = Canvas{root};
+        state = State::Opcode;
+        return false;
+    }
+
+    /// @brief Выполнить операцию с принятыми аргументами
+    Result<bool, Error> execute() noexcept {
+        switch (op) {
+            case draw_log::Op::Frame: {
+                const Pixel x = draw_log::readPixel(args);
+                const Pixel y = draw_log::readPixel(args + 2);
+                const Pixel w = draw_log::readPixel(args + 4);
+                const Pixel h = draw_log::readPixel(args + 6);
+
+                // FrameView::sub() не проверяет отрицательное смещение, а поток команд приходит извне
+                if (x < 0 or y < 0 or w < 1 or h < 1 or x + w > root.width or y + h > root.height) {
+                    return fail(Error::FrameOutOfBounds);
+                }
+
+                const auto frame_result = root.sub(w, h, x, y);
+
+                if (not frame_result.isOk()) { return fail(Error::FrameOutOfBounds); }
+
+                canvas = Canvas{frame_result.ok().value()};
+            } break;
+
+            case draw_log::Op::Fill:
+                canvas.fill(args[0] != 0);
+                break;
+
+            case draw_log::Op::Dot:
+                canvas.dot(draw_log::readPixel(args), draw_log::readPixel(args + 2), args[4] != 0);
+                break;
+
+            case draw_log::Op::Line:
+                canvas.line(
+                    draw_log::readPixel(args),
+                    draw_log::readPixel(args + 2),
+                    draw_log::readPixel(args + 4),
+                    draw_log::readPixel(args + 6),
+                    args[8] != 0);
+                break;
+
+            case draw_log::Op::Rect:
+                canvas.rect(
+                    draw_log::readPixel(args),
+                    draw_log::readPixel(args + 2),
+                    draw_log::readPixel(args + 4),
+                    draw_log::readPixel(args + 6),
+                    static_cast<Canvas::Mode>(args[8]));
+                break;
+
+            case draw_log::Op::Circle:
+                canvas.circle(
+                    draw_log::readPixel(args),
+                    draw_log::readPixel(args + 2),
+                    draw_log::readPixel(args + 4),
+                    static_cast<Canvas::Mode>(args[6]));
+                break;
+
+            case draw_log::Op::Arc:
+                canvas.arc(
+                    draw_log::readPixel(args),
+                    draw_log::readPixel(args + 2),
+                    draw_log::readPixel(args + 4),
+                    static_cast<u16>(draw_log::readPixel(args + 6)),
+                    static_cast<u16>(draw_log::readPixel(args + 8)),
+                    args[10] != 0);
+                break;
+
+            case draw_log::Op::PatternLine:
+                canvas.line(
+                    draw_log::readPixel(args),
+                    draw_log::readPixel(args + 2),
+                    draw_log::readPixel(args + 4),
+                    draw_log::readPixel(args + 6),
+                    LinePattern{draw_log::readU32(args + 8), args[12], args[13]},
+                    args[14] != 0);
+                break;
+
+            case draw_log::Op::Bitmap:
+                // Незарегистрированный битмап пропускается
+                if (args[4] < bitmaps_count) {
+                    canvas.bitmap(draw_log::readPixel(args), draw_log::readPixel(args + 2), bitmaps[args[4]], args[5] != 0);
+                }
+                break;
+
+            case draw_log::Op::Text:
+                // Незарегистрированный шрифт заменяется пустым
+                canvas.setFont(args[0] < fonts_count ? *fonts[args[0]] : Font::blank());
+                canvas.setCursor(draw_log::readPixel(args + 1), draw_log::readPixel(args + 3));
+                canvas.auto_next_line = args[5] & draw_log::text_auto_next_line;
+                canvas.outline = args[5] & draw_log::text_outline;
+                text_on = args[5] & draw_log::text_on;
+                text_stopped = false;
+                state = State::TextChars;
+                return false;
+
+            case draw_log::Op::FrameEnd:
+                if (draw_log::hash(frame_buffer, frame_size) != draw_log::readU32(args)) { return Error::HashMismatch; }
+                break;
+        }
+
+        return true;
+    }
+
+    explicit DrawInterpreter(
+        u8 *frame_buffer,
+        usize frame_size,
+        const FrameView &root,
+        const Font *const *fonts,
+        u8 fonts_count,
+        const BitMapView *bitmaps,
+        u8 bitmaps_count) noexcept :
+        frame_buffer{frame_buffer},
+        frame_size{frame_size},
+        root{root},
+        canvas{root},
+        fonts{fonts},
+        bitmaps{bitmaps},
+        fonts_count{fonts_count},
+        bitmaps_count{bitmaps_count} {}
+};
+
+}// namespace kf::gfx
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <kf/units.hpp>
+
+
+namespace kf::gfx {
+
+/// @brief Бинарный журнал вызовов Canvas
+/// @details Заголовок: "KFDL", версия (u8), ширина и высота дисплея (i16)
+/// @details Записи: код операции (u8) и аргументы фиксированной длины
+/// @details Координаты записываются как i16 little-endian
+namespace draw_log {
+
+/// @brief Сигнатура журнала
+static constexpr u8 magic[4] = {'K', 'F', 'D', 'L'};
+
+/// @brief Версия формата
+static constexpr u8 version = 1;
+
+/// @brief Размер заголовка в байтах
+static constexpr usize header_size = 9;
+
+/// @brief Идентификатор незарегистрированного шрифта или битмапа
+static constexpr u8 unknown_id = 0xFF;
+
+/// @brief Флаг текста: цвет (включено)
+static constexpr u8 text_on = 0b01;
+
+/// @brief Флаг текста: автоматический перенос строки
+static constexpr u8 text_auto_next_line = 0b10;
+
+/// @brief Флаг текста: контур (Canvas::outline)
+static constexpr u8 text_outline = 0b100;
+
+/// @brief Коды операций
+enum class Op : u8 {
+
+    /// @brief Выбор области: x, y, width, height (абсолютные)
+    Frame = 0x01,
+
+    /// @brief Заливка области: value (u8)
+    Fill = 0x02,
+
+    /// @brief Точка: x, y, on (u8)
+    Dot = 0x03,
+
+    /// @brief Линия: x0, y0, x1, y1, on (u8)
+    Line = 0x04,
+
+    /// @brief Прямоугольник: x0, y0, x1, y1, mode (u8)
+    Rect = 0x05,
+
+    /// @brief Окружность: cx, cy, r, mode (u8)
+    Circle = 0x06,
+
+    /// @brief Битмап: x, y, id (u8), on (u8)
+    Bitmap = 0x07,
+
+    /// @brief Текст: font id (u8), cursor x, cursor y, flags (u8), символы до '\0'
+    Text = 0x08,
+
+    /// @brief Конец кадра: хеш буфера дисплея (u32)
+    FrameEnd = 0x09,
+
+    /// @brief Дуга: cx, cy, r, start (u16), end (u16), on (u8)
+    Arc = 0x0A,
+
+    /// @brief Линия по шаблону: x0, y0, x1, y1, bits (u32), length (u8), phase (u8), on (u8)
+    PatternLine = 0x0B,
+};
+
+/// @brief Размер аргументов операции в байтах (без символов текста)
+/// @returns 0 для неизвестной операции
+[[nodiscard]] constexpr usize argsSize(Op op) noexcept {
+    switch (op) {
+        case Op::Frame: return 8;
+        case Op::Fill: return 1;
+        case Op::Dot: return 5;
+        case Op::Line: return 9;
+        case Op::Rect: return 9;
+        case Op::Circle: return 7;
+        case Op::Bitmap: return 6;
+        case Op::Text: return 6;
+        case Op::FrameEnd: return 4;
+        case Op::Arc: return 11;
+        case Op::PatternLine: return 15;
+    }
+    return 0;
+}
+
+/// @brief Хеш буфера дисплея (FNV-1a)
+[[nodiscard]] constexpr u32 hash(const u8 *data, usize size) noexcept {
+    u32 h = 2166136261u;
+    for (usize i = 0; i < size; ++i) {
+        h = (h ^ data[i]) * 16777619u;
+    }
+    return h;
+}
+
+/// @brief Прочитать i16 little-endian
+[[nodiscard]] inline Pixel readPixel(const u8 *data) noexcept {
+    return static_cast<Pixel>(static_cast<u16>(data[0] | (data[1] << 8)));
+}
+
+/// @brief Прочитать u32 little-endian
+[[nodiscard]] inline u32 readU32(const u8 *data) noexcept {
+    return static_cast<u32>(data[0]) |
+           (static_cast<u32>(data[1]) << 8) |
+           (static_cast<u32>(data[2]) << 16) |
+           (static_cast<u32>(data[3]) << 24);
+}
+
+}// namespace draw_log
+}// namespace kf::gfx
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/BitMap.hpp"
+#include "kf/gfx/DrawInterpreter.hpp"
+#include "kf/gfx/DrawLog.hpp"
+#include "kf/gfx/Font.hpp"
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Воспроизведение журнала вызовов Canvas (см. DrawRecorder)
+/// @details Выполняет записи по одной, что позволяет замерять время каждого вызова
+/// @details Исполнение делегируется DrawInterpreter
+struct DrawPlayer final {
+
+    /// @brief Ошибки воспроизведения
+    enum class Error : u8 {
+
+        /// @brief Неверная сигнатура или размер заголовка
+        BadHeader,
+
+        /// @brief Неподдерживаемая версия формата
+        UnsupportedVersion,
+
+        /// @brief Буфер кадра не инициализирован
+        BufferNotInit,
+
+        /// @brief Журнал обрывается посреди записи
+        Truncated,
+
+        /// @brief Неизвестный код операции
+        UnknownOp,
+
+        /// @brief Область выходит за границы дисплея
+        FrameOutOfBounds,
+
+        /// @brief Хеш кадра не совпал с записанным
+        HashMismatch,
+    };
+
+private:
+    /// @brief Журнал
+    const u8 *log;
+
+    /// @brief Размер журнала
+    usize log_size;
+
+    /// @brief Позиция чтения
+    usize position;
+
+    /// @brief Ширина дисплея
+    Pixel display_width;
+
+    /// @brief Высота дисплея
+    Pixel display_height;
+
+    /// @brief Исполнитель команд
+    DrawInterpreter interpreter;
+
+public:
+    /// @brief Проверить заголовок журнала
+    /// @returns Размер буфера дисплея в байтах
+    [[nodiscard]] static Result<usize, Error> checkHeader(const u8 *log, usize log_size) noexcept {
+        if (nullptr == log or log_size < draw_log::header_size) { return Error::BadHeader; }
+
+        for (usize i = 0; i < sizeof(draw_log::magic); ++i) {
+            if (log[i] != draw_log::magic[i]) { return Error::BadHeader; }
+        }
+
+        if (log[4] != draw_log::version) { return Error::UnsupportedVersion; }
+
+        const Pixel width = draw_log::readPixel(log + 5);
+        const Pixel height = draw_log::readPixel(log + 7);
+        if (width < 1 or height < 1) { return Error::BadHeader; }
+
+        return static_cast<usize>(width) * ((height + 7) / 8);
+    }
+
+    /// @brief Создать проигрыватель, проверив заголовок журнала
+    [[nodiscard]] static Result<DrawPlayer, Error> create(
+        /// @brief Журнал
+        const u8 *log,
+
+        /// @brief Размер журнала
+        usize log_size,
+
+        /// @brief Буфер дисплея: width * ((height + 7) / 8) байт
+        u8 *frame_buffer,
+
+        /// @brief Таблица шрифтов (id = индекс)
+        const Font *const *fonts = nullptr,
+
+        /// @brief Количество шрифтов
+        u8 fonts_count = 0,
+
+        /// @brief Таблица битмапов (id = индекс)
+        const BitMapView *bitmaps = nullptr,
+
+        /// @brief Количество битмапов
+        u8 bitmaps_count = 0) noexcept {
+        const auto header_result = checkHeader(log, log_size);
+        if (not header_result.isOk()) { return header_result.error().value(); }
+
+        const Pixel width = draw_log::readPixel(log + 5);
+        const Pixel height = draw_log::readPixel(log + 7);
+
+        auto interpreter_result = DrawInterpreter::create(frame_buffer, width, height, fonts, fonts_count, bitmaps, bitmaps_count);
+        if (not interpreter_result.isOk()) { return Error::BufferNotInit; }
+
+        auto interpreter = interpreter_result.ok().value();
+        interpreter.feed(log, draw_log::header_size);
+
+        return DrawPlayer{log, log_size, width, height, interpreter};
+    }
+
+    /// @brief Ширина дисплея
+    [[nodiscard]] inline Pixel width() const noexcept { return display_width; }
+
+    /// @brief Высота дисплея
+    [[nodiscard]] inline Pixel height() const noexcept { return display_height; }
+
+    /// @brief Размер буфера дисплея в байтах
+    [[nodiscard]] inline usize frameSize() const noexcept { return display_width * ((display_height + 7) / 8); }
+
+    /// @brief Журнал воспроизведён полностью
+    [[nodiscard]] inline bool done() const noexcept { return position >= log_size; }
+
+    /// @brief Выполнить следующую запись журнала
+    /// @returns Код выполненной операции
+    Result<draw_log::Op, Error> step() noexcept {
+        if (done()) { return Error::Truncated; }
+
+        const auto op = static_cast<draw_log::Op>(log[position]);
+        const usize args_size = draw_log::argsSize(op);
+
+        if (args_size == 0) { return Error::UnknownOp; }
+        if (position + 1 + args_size > log_size) { return Error::Truncated; }
+
+        usize entry_size = 1 + args_size;
+
+        if (op == draw_log::Op::Text) {
+            while (position + entry_size < log_size and log[position + entry_size] != '\0') { entry_size += 1; }
+            if (position + entry_size >= log_size) { return Error::Truncated; }
+            entry_size += 1;
+        }
+
+        const auto result = interpreter.feed(log + position, entry_size);
+        position += entry_size;
+
+        if (not result.isOk()) {
+            switch (result.error().value()) {
+                case DrawInterpreter::Error::FrameOutOfBounds: return Error::FrameOutOfBounds;
+                case DrawInterpreter::Error::HashMismatch: return Error::HashMismatch;
+                default: return Error::UnknownOp;
+            }
+        }
+
+        return op;
+    }
+
+private:
+    explicit DrawPlayer(
+        const u8 *log,
+        usize log_size,
+        Pixel display_width,
+        Pixel display_height,
+        const DrawInterpreter &interpreter) noexcept :
+        log{log},
+        log_size{log_size},
+        position{draw_log::header_size},
+        display_width{display_width},
+        display_height{display_height},
+        interpreter{interpreter} {}
+};
+
+}// namespace kf::gfx
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <cstring>
+
+#include <kf/units.hpp>
+
+#include "kf/gfx/BitMap.hpp"
+#include "kf/gfx/DrawLog.hpp"
+#include "kf/gfx/Font.hpp"
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Запись вызовов Canvas в бинарный журнал (см. draw_log)
+/// @details Пишет в буфер вызывающей стороны, не выделяет память
+/// @details Шрифты и битмапы записываются по индексу в переданных таблицах
+/// @details При нехватке места запись прекращается, журнал остаётся корректным префиксом
+struct DrawRecorder final {
+
+private:
+    /// @brief Буфер журнала
+    u8 *buffer;
+
+    /// @brief Ёмкость буфера
+    usize capacity;
+
+    /// @brief Занятый объём
+    usize used{0};
+
+    /// @brief Таблица шрифтов
+    const Font *const *fonts;
+
+    /// @brief Количество шрифтов
+    u8 fonts_count;
+
+    /// @brief Таблица битмапов
+    const BitMapView *bitmaps;
+
+    /// @brief Количество битмапов
+    u8 bitmaps_count;
+
+    /// @brief Последняя записанная область
+    FrameView last_frame{};
+
+    /// @brief Буфер переполнен, запись остановлена
+    bool overflow{false};
+
+public:
+    explicit DrawRecorder(
+        /// @brief Буфер журнала
+        u8 *buffer,
+
+        /// @brief Ёмкость буфера
+        usize capacity,
+
+        /// @brief Таблица шрифтов (id = индекс)
+        const Font *const *fonts = nullptr,
+
+        /// @brief Количество шрифтов
+        u8 fonts_count = 0,
+
+        /// @brief Таблица битмапов (id = индекс)
+        const BitMapView *bitmaps = nullptr,
+
+        /// @brief Количество битмапов
+        u8 bitmaps_count = 0) noexcept :
+        buffer{buffer},
+        capacity{capacity},
+        fonts{fonts},
+        fonts_count{fonts_count},
+        bitmaps{bitmaps},
+        bitmaps_count{bitmaps_count} {}
+
+    /// @brief Начать новый журнал для дисплея указанного размера
+    void begin(Pixel display_width, Pixel display_height) noexcept {
+        used = 0;
+        overflow = false;
+        last_frame = FrameView{};
+
+        if (capacity < draw_log::header_size) {
+            overflow = true;
+            return;
+        }
+
+        for (auto b: draw_log::magic) { put(b); }
+        put(draw_log::version);
+        putPixel(display_width);
+        putPixel(display_height);
+    }
+
+    /// @brief Очистить записанные данные, сохранив состояние сеанса
+    /// @details Для передачи журнала частями: следующая часть продолжает поток без заголовка
+    void clear() noexcept {
+        used = 0;
+        overflow = false;
+    }
+
+    /// @brief Данные журнала
+    [[nodiscard]] inline const u8 *data() const noexcept { return buffer; }
+
+    /// @brief Размер журнала в байтах
+    [[nodiscard]] inline usize size() const noexcept { return used; }
+
+    /// @brief Журнал не поместился в буфер
+    [[nodiscard]] inline bool overflowed() const noexcept { return overflow; }
+
+    /// @brief Записать заливку
+    void fill(const FrameView &frame, bool value) noexcept {
+        if (not beginEntry(frame, draw_log::Op::Fill, 0)) { return; }
+        put(value);
+    }
+
+    /// @brief Записать точку
+    void dot(const FrameView &frame, Pixel x, Pixel y, bool on) noexcept {
+        if (not beginEntry(frame, draw_log::Op::Dot, 0)) { return; }
+        putPixel(x);
+        putPixel(y);
+        put(on);
+    }
+
+    /// @brief Записать линию
+    void line(const FrameView &frame, Pixel x0, Pixel y0, Pixel x1, Pixel y1, bool on) noexcept {
+        if (not beginEntry(frame, draw_log::Op::Line, 0)) { return; }
+        putPixel(x0);
+        putPixel(y0);
+        putPixel(x1);
+        putPixel(y1);
+        put(on);
+    }
+
+    /// @brief Записать прямоугольник
+    void rect(const FrameView &frame, Pixel x0, Pixel y0, Pixel x1, Pixel y1, u8 mode) noexcept {
+        if (not beginEntry(frame, draw_log::Op::Rect, 0)) { return; }
+        putPixel(x0);
+        putPixel(y0);
+        putPixel(x1);
+        putPixel(y1);
+        put(mode);
+    }
+
+    /// @brief Записать окружность
+    void circle(const FrameView &frame, Pixel center_x, Pixel center_y, Pixel r, u8 mode) noexcept {
+        if (not beginEntry(frame, draw_log::Op::Circle, 0)) { return; }
+        putPixel(center_x);
+        putPixel(center_y);
+        putPixel(r);
+        put(mode);
+    }
+
+    /// @brief Записать дугу
+    void arc(const FrameView &frame, Pixel center_x, Pixel center_y, Pixel r, u16 start, u16 end, bool on) noexcept {
+        if (not beginEntry(frame, draw_log::Op::Arc, 0)) { return; }
+        putPixel(center_x);
+        putPixel(center_y);
+        putPixel(r);
+        putPixel(static_cast<Pixel>(start));
+        putPixel(static_cast<Pixel>(end));
+        put(on);
+    }
+
+    /// @brief Записать линию по шаблону
+    void patternLine(const FrameView &frame, Pixel x0, Pixel y0, Pixel x1, Pixel y1, const LinePattern &pattern, bool on) noexcept {
+        if (not beginEntry(frame, draw_log::Op::PatternLine, 0)) { return; }
+        putPixel(x0);
+        putPixel(y0);
+        putPixel(x1);
+        putPixel(y1);
+        for (u8 i = 0; i < 4; ++i) { put(static_cast<u8>(pattern.bits >> (i * 8))); }
+        put(pattern.length);
+        put(pattern.phase);
+        put(on);
+    }
+
+    /// @brief Записать битмап
+    void bitmap(const FrameView &frame, Pixel x, Pixel y, const BitMapView &bitmap, bool on) noexcept {
+        if (not beginEntry(frame, draw_log::Op::Bitmap, 0)) { return; }
+        putPixel(x);
+        putPixel(y);
+        put(findBitmap(bitmap));
+        put(on);
+    }
+
+    /// @brief Записать текст вместе с состоянием курсора и шрифтом
+    void text(
+        const FrameView &frame,
+        const Font &font,
+        Pixel cursor_x,
+        Pixel cursor_y,
+        bool auto_next_line,
+        bool outline,
+        const char *text,
+        bool on) noexcept {
+        const usize length = std::strlen(text) + 1;
+        if (not beginEntry(frame, draw_log::Op::Text, length)) { return; }
+
+        put(findFont(font));
+        putPixel(cursor_x);
+        putPixel(cursor_y);
+        put(static_cast<u8>(
+            (on ? draw_log::text_on : 0) |
+            (auto_next_line ? draw_log::text_auto_next_line : 0) |
+            (outline ? draw_log::text_outline : 0)));
+        std::memcpy(buffer + used, text, length);
+        used += length;
+    }
+
+    /// @brief Записать конец кадра с хешем буфера дисплея
+    void frameEnd(const u8 *frame_buffer, usize frame_size) noexcept {
+        if (not reserve(1 + draw_log::argsSize(draw_log::Op::FrameEnd))) { return; }
+
+        put(static_cast<u8>(draw_log::Op::FrameEnd));
+        const u32 h = draw_log::hash(frame_buffer, frame_size);
+        for (u8 i = 0; i < 4; ++i) { put(static_cast<u8>(h >> (i * 8))); }
+    }
+
+private:
+    /// @brief Зарезервировать место под запись целиком
+    bool reserve(usize bytes) noexcept {
+        if (overflow or used + bytes > capacity) {
+            overflow = true;
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Начать запись операции, при смене области предварить её записью Frame
+    bool beginEntry(const FrameView &frame, draw_log::Op op, usize extra) noexcept {
+        const bool frame_changed = frame.offset_x != last_frame.offset_x or
+                                   frame.offset_y != last_frame.offset_y or
+                                   frame.width != last_frame.width or
+                                   frame.height != last_frame.height;
+
+        const usize frame_entry = frame_changed ? 1 + draw_log::argsSize(draw_log::Op::Frame) : 0;
+
+        if (not reserve(frame_entry + 1 + draw_log::argsSize(op) + extra)) { return false; }
+
+        if (frame_changed) {
+            put(static_cast<u8>(draw_log::Op::Frame));
+            putPixel(frame.offset_x);
+            putPixel(frame.offset_y);
+            putPixel(frame.width);
+            putPixel(frame.height);
+            last_frame = frame;
+        }
+
+        put(static_cast<u8>(op));
+        return true;
+    }
+
+    /// @brief Найти id шрифта
+    [[nodiscard]] u8 findFont(const Font &font) const noexcept {
+        for (u8 i = 0; i < fonts_count; ++i) {
+            if (fonts[i] == &font) { return i; }
+        }
+        return draw_log::unknown_id;
+    }
+
+    /// @brief Найти id битмапа (по буферу)
+    [[nodiscard]] u8 findBitmap(const BitMapView &bitmap) const noexcept {
+        for (u8 i = 0; i < bitmaps_count; ++i) {
+            if (bitmaps[i].buffer == bitmap.buffer) { return i; }
+        }
+        return draw_log::unknown_id;
+    }
+
+    inline void put(u8 value) noexcept { buffer[used++] = value; }
+
+    inline void putPixel(Pixel value) noexcept {
+        const auto raw = static_cast<u16>(value);
+        put(static_cast<u8>(raw));
+        put(static_cast<u8>(raw >> 8));
+    }
+};
+
+}// namespace kf::gfx
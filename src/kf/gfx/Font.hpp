@@ -11,7 +11,7 @@ struct Font final {
     static constexpr char start_char = 32;
 
     /// @brief Код последнего символа в шрифте
-    static constexpr char end_char = 127;
+    static constexpr char end_char = 126;
 
     /// @brief Данные шрифта (массив глифов)
     const u8 *data;
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+
+namespace kf::gfx {
+
+/// @brief Дельта-кодирование кадров: XOR с предыдущим кадром и RLE по байтам страниц
+/// @details Токены потока:
+/// @details <code>0x00..0x7F</code> - пропуск (t + 1) неизменных байт
+/// @details <code>0x80..0xBF</code> - (t - 0x80 + 1) байт XOR следуют за токеном
+/// @details <code>0xC0..0xFF</code> - следующий байт XOR повторяется (t - 0xC0 + 1) раз
+/// @details Завершающие неизменные байты не кодируются: неизменный кадр даёт пустую дельту
+namespace frame_delta {
+
+/// @brief Ошибки декодирования
+enum class Error : u8 {
+
+    /// @brief Дельта выходит за пределы кадра
+    Overrun,
+
+    /// @brief Поток обрывается посреди токена
+    Truncated,
+};
+
+/// @brief Диапазон изменённых байт кадра [begin, end)
+struct Span final {
+
+    /// @brief Первый изменённый байт
+    usize begin;
+
+    /// @brief Байт за последним изменённым
+    usize end;
+
+    /// @brief Изменений нет
+    [[nodiscard]] inline bool empty() const noexcept { return begin >= end; }
+};
+
+/// @brief Максимальная длина пропуска
+static constexpr usize max_skip = 128;
+
+/// @brief Максимальная длина литерала и повтора
+static constexpr usize max_run = 64;
+
+/// @brief Размер дельты в худшем случае
+[[nodiscard]] constexpr usize maxEncodedSize(usize frame_size) noexcept {
+    return frame_size + (frame_size + max_run - 1) / max_run;
+}
+
+/// @brief Закодировать XOR двух кадров
+/// @param put Приёмник байт: <code>void(u8)</code>
+/// @returns Размер дельты в байтах
+template<typename Put> usize encode(const u8 *current, const u8 *previous, usize size, Put &&put) noexcept {
+    // Завершающие неизменные байты не кодируются
+    while (size > 0 and current[size - 1] == previous[size - 1]) { size -= 1; }
+
+    const auto delta = [current, previous](usize i) -> u8 { return current[i] ^ previous[i]; };
+
+    usize written = 0;
+    usize i = 0;
+
+    while (i < size) {
+        const u8 d = delta(i);
+
+        if (d == 0) {
+            usize run = 1;
+            while (i + run < size and run < max_skip and delta(i + run) == 0) { run += 1; }
+
+            put(static_cast<u8>(run - 1));
+            written += 1;
+            i += run;
+            continue;
+        }
+
+        usize repeat = 1;
+        while (i + repeat < size and repeat < max_run and delta(i + repeat) == d) { repeat += 1; }
+
+        if (repeat >= 3) {
+            put(static_cast<u8>(0xC0 | (repeat - 1)));
+            put(d);
+            written += 2;
+            i += repeat;
+            continue;
+        }
+
+        // Литерал до пары нулей или повтора из трёх байт
+        usize length = 1;
+        while (i + length < size and length < max_run) {
+            const usize j = i + length;
+            const u8 dj = delta(j);
+
+            if (dj == 0 and (j + 1 >= size or delta(j + 1) == 0)) { break; }
+            if (j + 2 < size and dj == delta(j + 1) and dj == delta(j + 2)) { break; }
+
+            length += 1;
+        }
+
+        put(static_cast<u8>(0x80 | (length - 1)));
+        for (usize k = 0; k < length; ++k) { put(delta(i + k)); }
+        written += 1 + length;
+        i += length;
+    }
+
+    return written;
+}
+
+/// @brief Размер дельты двух кадров без записи
+[[nodiscard]] inline usize encodedSize(const u8 *current, const u8 *previous, usize size) noexcept {
+    return encode(current, previous, size, [](u8) {});
+}
+
+/// @brief Декодировать дельту
+/// @param get Источник байт дельты: <code>u8(usize index)</code>
+/// @param apply_xor Приёмник: <code>void(usize index, u8 data)</code> - байт кадра index ^= data
+/// @returns Диапазон изменённых байт
+template<typename Get, typename ApplyXor> Result<Span, Error> decode(
+    Get &&get,
+    usize data_size,
+    usize target_size,
+    ApplyXor &&apply_xor) noexcept {
+    Span span{target_size, 0};
+    usize position = 0;
+    usize i = 0;
+
+    while (i < data_size) {
+        const u8 token = get(i);
+        i += 1;
+
+        if (token < 0x80) {
+            position += token + 1;
+            continue;
+        }
+
+        const usize length = (token & 0x3F) + 1;
+        if (position + length > target_size) { return Error::Overrun; }
+
+        if (token < 0xC0) {
+            if (i + length > data_size) { return Error::Truncated; }
+            for (usize k = 0; k < length; ++k) { apply_xor(position + k, get(i + k)); }
+            i += length;
+        } else {
+            if (i >= data_size) { return Error::Truncated; }
+            const u8 d = get(i);
+            for (usize k = 0; k < length; ++k) { apply_xor(position + k, d); }
+            i += 1;
+        }
+
+        if (position < span.begin) { span.begin = position; }
+        span.end = position + length;
+        position += length;
+    }
+
+    if (span.empty()) { return Span{0, 0}; }
+    return span;
+}
+
+/// @brief Применить дельту к кадру (target ^= delta)
+/// @returns Диапазон изменённых байт
+inline Result<Span, Error> apply(const u8 *data, usize data_size, u8 *target, usize target_size) noexcept {
+    return decode(
+        [data](usize i) { return data[i]; },
+        data_size,
+        target_size,
+        [target](usize i, u8 d) { target[i] ^= d; });
+}
+
+}// namespace frame_delta
+}// namespace kf::gfx
@@ -6,6 +6,7 @@
 #include <kf/units.hpp>
 
 #include "kf/gfx/BitMap.hpp"
+#include "kf/gfx/LinePattern.hpp"
 
 namespace kf::gfx {
 
@@ -29,6 +30,22 @@ public:
         OffsetOutOfBounds,
     };
 
+    /// @brief Растровая операция записи
+    enum class RasterOp : u8 {
+
+        /// @brief Копировать (target = source)
+        Copy,
+
+        /// @brief Включить (target |= source)
+        Or,
+
+        /// @brief Выключить (target &= ~source)
+        Clear,
+
+        /// @brief Инвертировать (target ^= source)
+        Xor,
+    };
+
 private:
     /// @brief Указатель на буфер дисплея
     u8 *buffer;
@@ -207,15 +224,179 @@ public:
         }
     }
 
+    /// @brief Рисует горизонтальный отрезок строки y от x0 до x1 включительно
+    void drawHorizontalSpan(Pixel x0, Pixel x1, Pixel y, bool on) const noexcept {
+        if (not isValid() or y < 0 or y >= height) { return; }
+        if (x0 > x1) { std::swap(x0, x1); }
+
+        x0 = std::max(x0, static_cast<Pixel>(0));
+        x1 = std::min(x1, static_cast<Pixel>(width - 1));
+
+        const Pixel page = getPage(y);
+        const u8 mask = getBitMask(y);
+
+        for (Pixel x = x0; x <= x1; ++x) {
+            writeData(toAbsoluteX(x), page, mask, on);
+        }
+    }
+
+    /// @brief Рисует вертикальный отрезок столбца x от y0 до y1 включительно
+    /// @details Записывает не более одного байта на страницу
+    void drawVerticalSpan(Pixel x, Pixel y0, Pixel y1, bool on) const noexcept {
+        if (not isValid() or x < 0 or x >= width) { return; }
+        if (y0 > y1) { std::swap(y0, y1); }
+
+        y0 = std::max(y0, static_cast<Pixel>(0));
+        y1 = std::min(y1, static_cast<Pixel>(height - 1));
+        if (y0 > y1) { return; }
+
+        const Pixel abs_x = toAbsoluteX(x);
+        const Pixel abs_y0 = toAbsoluteY(y0);
+        const Pixel abs_y1 = toAbsoluteY(y1);
+        const auto first_page = static_cast<Pixel>(abs_y0 >> 3);
+        const auto last_page = static_cast<Pixel>(abs_y1 >> 3);
+
+        for (Pixel page = first_page; page <= last_page; ++page) {
+            const auto start_bit = static_cast<u8>(page == first_page ? abs_y0 & 0x07 : 0);
+            const auto end_bit = static_cast<u8>(page == last_page ? abs_y1 & 0x07 : 7);
+            writeData(abs_x, page, createPageMask(start_bit, end_bit), on);
+        }
+    }
+
+    /// @brief Рисует горизонтальный отрезок строки y от x0 до x1 включительно по шаблону
+    /// @details Позиция в шаблоне - X. Шаблон выбирается по 8 пикселей, записываются только включённые
+    void drawHorizontalSpan(Pixel x0, Pixel x1, Pixel y, bool on, const LinePattern &pattern) const noexcept {
+        if (not isValid() or y < 0 or y >= height or pattern.period() == 0) { return; }
+        if (x0 > x1) { std::swap(x0, x1); }
+
+        x0 = std::max(x0, static_cast<Pixel>(0));
+        x1 = std::min(x1, static_cast<Pixel>(width - 1));
+
+        const Pixel page = getPage(y);
+        const u8 mask = getBitMask(y);
+        const u64 tile = pattern.tile();
+        const auto step = static_cast<u8>(8 % pattern.period());
+        u8 offset = pattern.offset(x0);
+
+        for (Pixel x = x0; x <= x1; x = static_cast<Pixel>(x + 8), offset = pattern.advance(offset, step)) {
+            auto run = static_cast<u8>(tile >> offset);
+            if (x1 - x < 7) { run &= static_cast<u8>((1u << (x1 - x + 1)) - 1); }
+
+            for (Pixel abs_x = toAbsoluteX(x); run != 0; run >>= 1, ++abs_x) {
+                if (run & 1) { writeData(abs_x, page, mask, on); }
+            }
+        }
+    }
+
+    /// @brief Рисует вертикальный отрезок столбца x от y0 до y1 включительно по шаблону
+    /// @details Позиция в шаблоне - Y. Маска страницы - 8 бит шаблона, записывается не более одного байта на страницу
+    void drawVerticalSpan(Pixel x, Pixel y0, Pixel y1, bool on, const LinePattern &pattern) const noexcept {
+        if (not isValid() or x < 0 or x >= width or pattern.period() == 0) { return; }
+        if (y0 > y1) { std::swap(y0, y1); }
+
+        y0 = std::max(y0, static_cast<Pixel>(0));
+        y1 = std::min(y1, static_cast<Pixel>(height - 1));
+        if (y0 > y1) { return; }
+
+        const Pixel abs_x = toAbsoluteX(x);
+        const Pixel abs_y0 = toAbsoluteY(y0);
+        const Pixel abs_y1 = toAbsoluteY(y1);
+        const auto first_page = static_cast<Pixel>(abs_y0 >> 3);
+        const auto last_page = static_cast<Pixel>(abs_y1 >> 3);
+        const u64 tile = pattern.tile();
+        const auto step = static_cast<u8>(8 % pattern.period());
+
+        // Строка области, соответствующая биту 0 первой страницы
+        u8 offset = pattern.offset(static_cast<Pixel>((first_page << 3) - offset_y));
+
+        for (Pixel page = first_page; page <= last_page; ++page, offset = pattern.advance(offset, step)) {
+            const auto start_bit = static_cast<u8>(page == first_page ? abs_y0 & 0x07 : 0);
+            const auto end_bit = static_cast<u8>(page == last_page ? abs_y1 & 0x07 : 7);
+            const auto mask = static_cast<u8>(createPageMask(start_bit, end_bit) & static_cast<u8>(tile >> offset));
+            if (mask != 0) { writeData(abs_x, page, mask, on); }
+        }
+    }
+
+    /// @brief Записывает столбец до 16 пикселей начиная с (x, y)
+    /// @param bits Значения пикселей (бит 0 соответствует строке y)
+    /// @param mask Маска записываемых пикселей
+    /// @param op Растровая операция
+    void writeColumn(Pixel x, Pixel y, u16 bits, u16 mask, RasterOp op = RasterOp::Copy) const noexcept {
+        if (not isValid() or x < 0 or x >= width or y >= height) { return; }
+
+        // Отсечение сверху
+        if (y < 0) {
+            if (y <= -16) { return; }
+            bits = static_cast<u16>(bits >> -y);
+            mask = static_cast<u16>(mask >> -y);
+            y = 0;
+        }
+
+        // Отсечение снизу
+        const auto rows = static_cast<Pixel>(height - y);
+        if (rows < 16) { mask &= static_cast<u16>((1u << rows) - 1); }
+        if (mask == 0) { return; }
+
+        const Pixel abs_x = toAbsoluteX(x);
+        const auto shift = static_cast<u8>(toAbsoluteY(y) & 0x07);
+        auto page = getPage(y);
+        u32 page_mask = static_cast<u32>(mask) << shift;
+        u32 page_bits = static_cast<u32>(bits) << shift;
+
+        for (; page_mask != 0; page_mask >>= 8, page_bits >>= 8, ++page) {
+            const auto m = static_cast<u8>(page_mask);
+            if (m == 0) { continue; }
+
+            writeMasked(buffer[page * stride + abs_x], static_cast<u8>(page_bits), m, op);
+        }
+    }
+
+    /// @brief Записывает полосу до 8 строк начиная с (x, y)
+    /// @param strip Байты столбцов (бит 0 соответствует строке y)
+    /// @param count Количество столбцов
+    /// @param rows Количество строк полосы (1-8)
+    void writeStrip(Pixel x, Pixel y, const u8 *strip, Pixel count, Pixel rows) const noexcept {
+        const auto mask = static_cast<u8>((1u << rows) - 1);
+
+        // Полоса на границе страницы целиком внутри области по Y: байт полосы - байт страницы
+        if (isValid() and (toAbsoluteY(y) & 0x07) == 0 and y >= 0 and y + rows <= height) {
+            const Pixel begin = std::max(static_cast<Pixel>(0), static_cast<Pixel>(-x));
+            const auto end = static_cast<Pixel>(std::min(static_cast<int>(count), width - x));
+            const Pixel page = getPage(y);
+
+            for (Pixel i = begin; i < end; ++i) {
+                writeMaskedData(toAbsoluteX(static_cast<Pixel>(x + i)), page, strip[i], mask);
+            }
+            return;
+        }
+
+        for (Pixel i = 0; i < count; ++i) {
+            writeColumn(static_cast<Pixel>(x + i), y, strip[i], mask);
+        }
+    }
+
     /// @brief Рисует битмап в указанной позиции
-    template<Pixel W, Pixel H> void drawBitmap(Pixel x, Pixel y, const BitMap<W, H> &bitmap, bool on = true) noexcept {
-        for (Pixel page_idx = 0; page_idx < BitMap<W, H>::pages; ++page_idx) {
+    template<Pixel W, Pixel H> inline void drawBitmap(Pixel x, Pixel y, const BitMap<W, H> &bitmap, bool on = true) noexcept {
+        drawBitmap(x, y, bitmap.view(), on);
+    }
+
+    /// @brief Рисует битмап в указанной позиции
+    void drawBitmap(Pixel x, Pixel y, const BitMapView &bitmap, bool on = true) noexcept {
+        const Pixel pages = bitmap.pages();
+
+        for (Pixel page_idx = 0; page_idx < pages; ++page_idx) {
             const auto page_y = static_cast<Pixel>(toAbsoluteY(y) + (page_idx << 3));
 
             // Пропуск невидимых страниц
             if (page_y + 7 < offset_y or page_y >= offset_y + height) { continue; }
 
-            const u8 mask = calculateBitmapMask(page_y);
+            u8 mask = calculateBitmapMask(page_y);
+
+            // Биты последней страницы за пределами высоты не относятся к изображению
+            if (page_idx == pages - 1) {
+                mask &= createPageMask(0, static_cast<u8>((bitmap.height - 1) & 0x07));
+            }
+
             if (mask == 0) { continue; }
 
             drawBitmapRow(bitmap, page_idx, x, page_y, mask, on);
@@ -278,17 +459,17 @@ public:
     }
 
     /// @brief Рисует строку битмапа
-    template<Pixel W, Pixel H> inline void drawBitmapRow(
-        const BitMap<W, H> &bitmap,
+    inline void drawBitmapRow(
+        const BitMapView &bitmap,
         Pixel page_idx,
         Pixel x,
         Pixel page_y,
         u8 mask,
         bool on) noexcept {
-        const u8 *source = bitmap.buffer + page_idx * W;
+        const u8 *source = bitmap.buffer + page_idx * bitmap.width;
         const auto abs_x = static_cast<Pixel>(offset_x + x);
 
-        for (Pixel bx = 0; bx < W; ++bx) {
+        for (Pixel bx = 0; bx < bitmap.width; ++bx) {
             const auto target_x = static_cast<Pixel>(abs_x + bx);
             if (target_x < offset_x or target_x >= offset_x + width) { continue; }
 
@@ -308,11 +489,17 @@ public:
             writeData(abs_x, page, data, on);
         } else {
             // Верхняя часть (текущая страница)
-            writeData(abs_x, page, data << offset, on);
+            const auto upper = static_cast<u8>(data << offset);
+            if (upper != 0) {
+                writeData(abs_x, page, upper, on);
+            }
 
             // Нижняя часть (следующая страница)
-            const auto next_page = static_cast<Pixel>(page + 1);
-            writeData(abs_x, next_page, data >> (8 - offset), on);
+            // Пустая часть не записывается: следующей страницы может не быть в буфере
+            const auto lower = static_cast<u8>(data >> (8 - offset));
+            if (lower != 0) {
+                writeData(abs_x, static_cast<Pixel>(page + 1), lower, on);
+            }
         }
     }
 
@@ -334,6 +521,26 @@ public:
         }
     }
 
+    /// @brief Читает байт буфера
+    [[nodiscard]] inline u8 readData(Pixel abs_x, Pixel page) const noexcept {
+        return buffer[page * stride + abs_x];
+    }
+
+    /// @brief Записывает байт буфера под маской с растровой операцией
+    inline void writeMaskedData(Pixel abs_x, Pixel page, u8 data, u8 mask, RasterOp op = RasterOp::Copy) const noexcept {
+        writeMasked(buffer[page * stride + abs_x], data, mask, op);
+    }
+
+    /// @brief Записывает байт под маской с растровой операцией
+    static inline void writeMasked(u8 &target, u8 data, u8 mask, RasterOp op) noexcept {
+        switch (op) {
+            case RasterOp::Copy: target = static_cast<u8>((target & ~mask) | (data & mask)); return;
+            case RasterOp::Or: target |= data & mask; return;
+            case RasterOp::Clear: target &= static_cast<u8>(~(data & mask)); return;
+            case RasterOp::Xor: target ^= data & mask; return;
+        }
+    }
+
     /// @brief Создает битовую маску для диапазона битов
     static inline u8 createPageMask(u8 start_bit, u8 end_bit) noexcept {
         if (start_bit > end_bit) { return 0; }
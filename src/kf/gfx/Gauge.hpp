@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/Canvas.hpp"
+#include "kf/gfx/FrameView.hpp"
+#include "kf/gfx/Trig.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Круглый стрелочный индикатор
+/// @details Шкала (дуга, деления, ось) рисуется один раз в собственный буфер.
+/// При смене значения из буфера восстанавливается только прямоугольник, описанный
+/// вокруг старой стрелки, затем рисуется новая: стоимость обновления пропорциональна
+/// размеру стрелки, а не шкалы
+/// @tparam Size Сторона квадрата индикатора в пикселях
+template<Pixel Size> struct Gauge final {
+
+    /// @brief Количество страниц буфера шкалы
+    static constexpr Pixel pages = (Size + 7) / 8;
+
+    /// @brief Центр (по обеим осям)
+    static constexpr Pixel center = (Size - 1) / 2;
+
+    /// @brief Радиус шкалы
+    static constexpr Pixel radius = center;
+
+    /// @brief Ошибки
+    enum class Error : u8 {
+
+        /// @brief min >= max или нулевой угол шкалы
+        BadRange,
+    };
+
+private:
+    /// @brief Буфер шкалы
+    u8 face_buffer[Size * pages]{};
+
+    /// @brief Начало шкалы
+    i32 min;
+
+    /// @brief Конец шкалы
+    i32 max;
+
+    /// @brief Угол начала шкалы
+    trig::Angle start;
+
+    /// @brief Угол шкалы от начала до конца
+    trig::Angle sweep;
+
+    /// @brief Значение пикселей шкалы и стрелки
+    bool on;
+
+    /// @brief Угол стрелки
+    trig::Angle angle;
+
+    /// @brief Угол стрелки на экране
+    trig::Angle shown_angle{0};
+
+    /// @brief Длина стрелки на экране
+    Pixel shown_length{0};
+
+    /// @brief Прямоугольник стрелки на экране (включительно, в координатах индикатора)
+    Pixel box_x0{0}, box_y0{0}, box_x1{Size - 1}, box_y1{Size - 1};
+
+    /// @brief Положение на экране
+    Pixel last_x{0}, last_y{0};
+
+    /// @brief Перерисовать всё
+    bool redraw_all{true};
+
+public:
+    /// @brief Длина стрелки (при отрисовке ограничивается radius, чтобы стрелка не выходила за квадрат индикатора)
+    /// @details Смена длины перерисовывает стрелку при следующем render(), как и смена значения
+    Pixel needle_length{radius * 3 / 4};
+
+    /// @brief Создать индикатор с делениями по умолчанию
+    /// @param start Угол значения min (по умолчанию 135° - слева снизу)
+    /// @param sweep Угол шкалы по часовой стрелке (по умолчанию 270°)
+    /// @param on Значение пикселей шкалы и стрелки
+    [[nodiscard]] static Result<Gauge, Error> create(
+        i32 min,
+        i32 max,
+        trig::Angle start = trig::fromDegrees(135),
+        trig::Angle sweep = trig::fromDegrees(270),
+        bool on = true) noexcept {
+        if (min >= max or sweep == 0) { return Error::BadRange; }
+
+        Gauge gauge{min, max, start, sweep, on};
+        gauge.drawFace();
+        return gauge;
+    }
+
+    /// @brief Область шкалы для рисования через Canvas (подписи и т.п.)
+    /// @details После изменения шкалы нужен invalidate()
+    [[nodiscard]] FrameView face() noexcept {
+        return FrameView{face_buffer, Size, Size, Size, 0, 0};
+    }
+
+    /// @brief Нарисовать шкалу заново: дуга, деления, ось стрелки
+    /// @param major Количество крупных делений (включая концы шкалы)
+    /// @param minor Мелких делений между крупными
+    void drawFace(u8 major = 6, u8 minor = 4) noexcept {
+        Canvas canvas{face()};
+        canvas.fill(not on);
+        canvas.arc(center, center, radius, start, static_cast<trig::Angle>(start + sweep), on);
+
+        const u16 steps = major > 1 ? static_cast<u16>((major - 1) * (minor + 1)) : 0;
+        for (u16 i = 0; i <= steps and steps != 0; ++i) {
+            const auto tick = static_cast<trig::Angle>(start + static_cast<u32>(sweep) * i / steps);
+            const auto length = static_cast<Pixel>(i % (minor + 1) == 0 ? radius / 5 : radius / 10);
+            canvas.needle(center, center, static_cast<Pixel>(radius - length), radius, tick, on);
+        }
+
+        canvas.circle(center, center, static_cast<Pixel>(std::max(1, radius / 12)), on ? Canvas::Mode::Fill : Canvas::Mode::Clear);
+        redraw_all = true;
+    }
+
+    /// @brief Установить значение (ограничивается шкалой)
+    void set(i32 value) noexcept {
+        value = std::min(std::max(value, min), max);
+        const auto offset = static_cast<u32>(value) - static_cast<u32>(min);
+        const auto range = static_cast<u32>(max) - static_cast<u32>(min);
+        angle = static_cast<trig::Angle>(start + static_cast<u64>(offset) * sweep / range);
+    }
+
+    /// @brief Перерисовать всё при следующем render()
+    void invalidate() noexcept { redraw_all = true; }
+
+    /// @brief Обновить индикатор на экране
+    /// @param x, y Левый верхний угол
+    /// @details Смена положения перерисовывает всё
+    /// @returns Количество восстановленных из шкалы столбцов страниц
+    usize render(const FrameView &target, Pixel x, Pixel y) noexcept {
+        if (not target.isValid()) { return 0; }
+
+        if (x != last_x or y != last_y) {
+            last_x = x;
+            last_y = y;
+            redraw_all = true;
+        }
+
+        // Новая стрелка в пределах буфера шкалы, иначе restore() прочтёт за его концом
+        const auto length = std::clamp(needle_length, static_cast<Pixel>(0), radius);
+
+        if (redraw_all) {
+            box_x0 = 0;
+            box_y0 = 0;
+            box_x1 = Size - 1;
+            box_y1 = Size - 1;
+        } else if (angle == shown_angle and length == shown_length) {
+            return 0;
+        }
+
+        const usize restored = restore(target, x, y);
+
+        // Новая стрелка и её прямоугольник
+        const auto tip_x = static_cast<Pixel>(center + trig::scale(length, trig::cos(angle)));
+        const auto tip_y = static_cast<Pixel>(center + trig::scale(length, trig::sin(angle)));
+
+        Canvas canvas{target};
+        canvas.line(
+            static_cast<Pixel>(x + center),
+            static_cast<Pixel>(y + center),
+            static_cast<Pixel>(x + tip_x),
+            static_cast<Pixel>(y + tip_y),
+            on);
+
+        box_x0 = std::min(center, tip_x);
+        box_y0 = std::min(center, tip_y);
+        box_x1 = std::max(center, tip_x);
+        box_y1 = std::max(center, tip_y);
+        shown_angle = angle;
+        shown_length = length;
+        redraw_all = false;
+        return restored;
+    }
+
+private:
+    Gauge(i32 min, i32 max, trig::Angle start, trig::Angle sweep, bool on) noexcept :
+        min{min}, max{max}, start{start}, sweep{sweep}, on{on}, angle{start} {}
+
+    /// @brief Восстановить прямоугольник стрелки из шкалы
+    /// @details Столбцы страниц шкалы записываются под маской строк прямоугольника
+    usize restore(const FrameView &target, Pixel x, Pixel y) const noexcept {
+        const auto first_page = static_cast<Pixel>(box_y0 >> 3);
+        const auto last_page = static_cast<Pixel>(box_y1 >> 3);
+
+        for (Pixel page = first_page; page <= last_page; ++page) {
+            const auto mask = FrameView::createPageMask(
+                static_cast<u8>(page == first_page ? box_y0 & 0x07 : 0),
+                static_cast<u8>(page == last_page ? box_y1 & 0x07 : 7));
+            const u8 *source = face_buffer + page * Size;
+            const auto row = static_cast<Pixel>(y + (page << 3));
+
+            for (Pixel column = box_x0; column <= box_x1; ++column) {
+                target.writeColumn(static_cast<Pixel>(x + column), row, source[column], mask);
+            }
+        }
+
+        return static_cast<usize>((last_page - first_page + 1) * (box_x1 - box_x0 + 1));
+    }
+};
+
+}// namespace kf::gfx
@@ -0,0 +1,446 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Потоковый декодер 1-битных изображений PBM (P1, P4), XBM и BMP
+/// @details Данные читаются построчно через функцию чтения, 8 строк собираются в полосу
+/// и переставляются блоками 8x8 в байты страниц, которые записываются прямо в область.
+/// Изображение целиком в памяти не хранится
+/// @details Чёрный (тёмный) пиксель изображения - включённый пиксель дисплея
+/// @tparam MaxWidth Максимальная ширина изображения
+template<Pixel MaxWidth> struct ImageDecoder final {
+
+    /// @brief Ошибки декодирования
+    enum class Error : u8 {
+
+        /// @brief Неизвестный формат или повреждённый заголовок
+        BadHeader,
+
+        /// @brief Формат не поддерживается (не 1 бит на пиксель, сжатие)
+        Unsupported,
+
+        /// @brief Ширина больше MaxWidth
+        TooWide,
+
+        /// @brief Данные обрываются
+        Truncated,
+    };
+
+    /// @brief Размер декодированного изображения
+    struct Size final {
+
+        /// @brief Ширина
+        Pixel width;
+
+        /// @brief Высота
+        Pixel height;
+    };
+
+    /// @brief Байт в строке изображения
+    static constexpr usize row_capacity = (MaxWidth + 7) / 8;
+
+private:
+    /// @brief Полоса из 8 упакованных строк (старший бит - левый пиксель)
+    u8 rows[8][row_capacity]{};
+
+    /// @brief Источник байт с возвратом одного байта
+    template<typename Read> struct Source final {
+
+        /// @brief Функция чтения: <code>usize(u8 *data, usize size)</code>
+        Read &read;
+
+        /// @brief Возвращённый байт (-1 - нет)
+        int pushed{-1};
+
+        /// @brief Прочитать байт
+        /// @returns -1 в конце данных
+        int get() noexcept {
+            if (pushed >= 0) {
+                const int c = pushed;
+                pushed = -1;
+                return c;
+            }
+
+            u8 byte;
+            return read(&byte, 1) == 1 ? byte : -1;
+        }
+
+        /// @brief Вернуть байт
+        void unget(int c) noexcept { pushed = c; }
+
+        /// @brief Прочитать блок
+        bool readExact(u8 *data, usize size) noexcept {
+            if (size == 0) { return true; }
+
+            usize offset = 0;
+            if (pushed >= 0) {
+                data[0] = static_cast<u8>(pushed);
+                pushed = -1;
+                offset = 1;
+            }
+
+            return read(data + offset, size - offset) == size - offset;
+        }
+
+        /// @brief Пропустить байты
+        bool skip(usize size) noexcept {
+            for (; size > 0; --size) {
+                if (get() < 0) { return false; }
+            }
+            return true;
+        }
+    };
+
+public:
+    /// @brief Декодировать изображение, определив формат по первому байту
+    /// @param read Функция чтения: <code>usize(u8 *data, usize size)</code> - количество прочитанных байт
+    /// @param x, y Позиция изображения в области
+    template<typename Read> Result<Size, Error> decode(Read &&read, const FrameView &target, Pixel x, Pixel y) noexcept {
+        Source<Read> source{read};
+        const int first = source.get();
+        source.unget(first);
+
+        switch (first) {
+            case 'P': return decodePbm(source, target, x, y);
+            case 'B': return decodeBmp(source, target, x, y);
+            case '#':
+            case '/':
+            case 's':
+                return decodeXbm(source, target, x, y);
+            default:
+                return Error::BadHeader;
+        }
+    }
+
+private:
+    /// @brief Начать новую полосу
+    void clearRows() noexcept { std::memset(rows, 0, sizeof(rows)); }
+
+    /// @brief Переставить блок 8x8: строки (старший бит - левый пиксель) в столбцы (бит 0 - верхняя строка)
+    static inline void transpose(const u8 *column_of_rows[8], usize byte, u8 *out) noexcept {
+        // Строки в обратном порядке: младший бит результата - верхняя строка
+        u64 m = 0;
+        for (u8 r = 0; r < 8; ++r) { m = (m << 8) | column_of_rows[7 - r][byte]; }
+
+        u64 t;
+        t = (m ^ (m >> 7)) & 0x00AA00AA00AA00AAull;
+        m = m ^ t ^ (t << 7);
+        t = (m ^ (m >> 14)) & 0x0000CCCC0000CCCCull;
+        m = m ^ t ^ (t << 14);
+        t = (m ^ (m >> 28)) & 0x00000000F0F0F0F0ull;
+        m = m ^ t ^ (t << 28);
+
+        for (u8 i = 0; i < 8; ++i) { out[i] = static_cast<u8>(m >> (56 - 8 * i)); }
+    }
+
+    /// @brief Записать полосу строк [first_row, first_row + count)
+    void flushRows(const FrameView &target, Pixel x, Pixel y, Pixel width, Pixel first_row, Pixel count) const noexcept {
+        const u8 *column_of_rows[8];
+        for (u8 r = 0; r < 8; ++r) { column_of_rows[r] = rows[r]; }
+
+        u8 columns[8];
+        const usize bytes = (width + 7) / 8;
+
+        for (usize byte = 0; byte < bytes; ++byte) {
+            transpose(column_of_rows, byte, columns);
+
+            const auto column = static_cast<Pixel>(byte * 8);
+            const auto valid = static_cast<Pixel>(std::min(8, width - column));
+            target.writeStrip(static_cast<Pixel>(x + column), static_cast<Pixel>(y + first_row), columns, valid, count);
+        }
+    }
+
+    /// @brief Пропустить пробелы и комментарии '#'
+    template<typename Read> static int skipSpaces(Source<Read> &source) noexcept {
+        int c = source.get();
+
+        for (;;) {
+            while (c == ' ' or c == '\t' or c == '\r' or c == '\n' or c == ',') { c = source.get(); }
+            if (c != '#') { return c; }
+            while (c != '\n' and c >= 0) { c = source.get(); }
+        }
+    }
+
+    /// @brief Прочитать десятичное число PBM
+    /// @returns -1, если числа нет
+    template<typename Read> static i32 readDecimal(Source<Read> &source) noexcept {
+        int c = skipSpaces(source);
+        if (c < '0' or c > '9') { return -1; }
+
+        i32 value = 0;
+        for (; c >= '0' and c <= '9'; c = source.get()) {
+            value = value * 10 + (c - '0');
+            if (value > 0x7FFF) { return -1; }
+        }
+
+        source.unget(c);
+        return value;
+    }
+
+    /// @brief Проверить размер изображения
+    [[nodiscard]] static Result<Size, Error> checkSize(i32 width, i32 height) noexcept {
+        if (width < 1 or height < 1 or height > 0x7FFF) { return Error::BadHeader; }
+        if (width > MaxWidth) { return Error::TooWide; }
+        return Size{static_cast<Pixel>(width), static_cast<Pixel>(height)};
+    }
+
+    template<typename Read> Result<Size, Error> decodePbm(Source<Read> &source, const FrameView &target, Pixel x, Pixel y) noexcept {
+        if (source.get() != 'P') { return Error::BadHeader; }
+
+        const int kind = source.get();
+        if (kind != '1' and kind != '4') { return kind == '2' or kind == '5' ? Error::Unsupported : Error::BadHeader; }
+
+        const i32 width = readDecimal(source);
+        const i32 height = readDecimal(source);
+
+        const auto size_result = checkSize(width, height);
+        if (not size_result.isOk()) { return size_result.error().value(); }
+        const Size size = size_result.ok().value();
+
+        const usize row_bytes = (size.width + 7) / 8;
+
+        // Один пробельный символ после заголовка P4
+        if (kind == '4') { source.get(); }
+
+        clearRows();
+
+        for (Pixel row = 0; row < size.height; ++row) {
+            u8 *packed = rows[row & 7];
+
+            if (kind == '4') {
+                if (not source.readExact(packed, row_bytes)) { return Error::Truncated; }
+                packed[row_bytes - 1] &= static_cast<u8>(0xFF << (row_bytes * 8 - size.width));
+            } else {
+                std::memset(packed, 0, row_bytes);
+
+                for (Pixel column = 0; column < size.width; ++column) {
+                    const int c = skipSpaces(source);
+                    if (c != '0' and c != '1') { return Error::Truncated; }
+                    if (c == '1') { packed[column >> 3] |= static_cast<u8>(0x80 >> (column & 7)); }
+                }
+            }
+
+            if ((row & 7) == 7 or row == size.height - 1) {
+                const auto first = static_cast<Pixel>(row & ~7);
+                flushRows(target, x, y, size.width, first, static_cast<Pixel>(row - first + 1));
+                clearRows();
+            }
+        }
+
+        return size;
+    }
+
+    /// @brief Прочитать слово XBM (идентификатор или число)
+    /// @returns Длина слова, 0 - конец данных
+    template<typename Read> static usize readWord(Source<Read> &source, char *word, usize capacity, int &delimiter) noexcept {
+        int c = source.get();
+
+        while (c >= 0 and not isWordChar(c)) {
+            if (c == '{' or c == '}') {
+                delimiter = c;
+                return 0;
+            }
+            c = source.get();
+        }
+
+        usize length = 0;
+        for (; c >= 0 and isWordChar(c); c = source.get()) {
+            if (length + 1 < capacity) { word[length++] = static_cast<char>(c); }
+        }
+
+        source.unget(c);
+        word[length] = '\0';
+        delimiter = c < 0 ? -1 : 0;
+        return length;
+    }
+
+    static inline bool isWordChar(int c) noexcept {
+        return (c >= '0' and c <= '9') or (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or c == '_';
+    }
+
+    static inline bool endsWith(const char *word, usize length, const char *suffix) noexcept {
+        const usize suffix_length = std::strlen(suffix);
+        return length >= suffix_length and std::strcmp(word + length - suffix_length, suffix) == 0;
+    }
+
+    /// @brief Разобрать число C (десятичное или 0x)
+    /// @returns -1, если это не число
+    static i32 parseNumber(const char *word) noexcept {
+        i32 base = 10;
+        if (word[0] == '0' and (word[1] == 'x' or word[1] == 'X')) {
+            base = 16;
+            word += 2;
+        }
+        if (*word == '\0') { return -1; }
+
+        i32 value = 0;
+        for (; *word != '\0'; ++word) {
+            const char c = *word;
+            i32 digit;
+
+            if (c >= '0' and c <= '9') {
+                digit = c - '0';
+            } else if (base == 16 and c >= 'a' and c <= 'f') {
+                digit = c - 'a' + 10;
+            } else if (base == 16 and c >= 'A' and c <= 'F') {
+                digit = c - 'A' + 10;
+            } else {
+                return -1;
+            }
+
+            value = value * base + digit;
+            if (value > 0x7FFF) { return -1; }
+        }
+
+        return value;
+    }
+
+    /// @brief Развернуть порядок бит байта (XBM: младший бит - левый пиксель)
+    static inline u8 reverseBits(u8 b) noexcept {
+        b = static_cast<u8>((b & 0xF0) >> 4 | (b & 0x0F) << 4);
+        b = static_cast<u8>((b & 0xCC) >> 2 | (b & 0x33) << 2);
+        b = static_cast<u8>((b & 0xAA) >> 1 | (b & 0x55) << 1);
+        return b;
+    }
+
+    template<typename Read> Result<Size, Error> decodeXbm(Source<Read> &source, const FrameView &target, Pixel x, Pixel y) noexcept {
+        char word[64];
+        int delimiter = 0;
+        i32 width = -1;
+        i32 height = -1;
+
+        // #define <name>_width N, #define <name>_height N, затем '{'
+        for (;;) {
+            const usize length = readWord(source, word, sizeof(word), delimiter);
+
+            if (length == 0) {
+                if (delimiter == '{') { break; }
+                return delimiter < 0 ? Error::Truncated : Error::BadHeader;
+            }
+
+            const bool is_width = endsWith(word, length, "_width");
+            const bool is_height = endsWith(word, length, "_height");
+            if (not is_width and not is_height) { continue; }
+
+            const usize value_length = readWord(source, word, sizeof(word), delimiter);
+            if (value_length == 0) { return Error::BadHeader; }
+
+            (is_width ? width : height) = parseNumber(word);
+        }
+
+        const auto size_result = checkSize(width, height);
+        if (not size_result.isOk()) { return size_result.error().value(); }
+        const Size size = size_result.ok().value();
+
+        const usize row_bytes = (size.width + 7) / 8;
+        clearRows();
+
+        for (Pixel row = 0; row < size.height; ++row) {
+            u8 *packed = rows[row & 7];
+
+            for (usize byte = 0; byte < row_bytes; ++byte) {
+                if (readWord(source, word, sizeof(word), delimiter) == 0) { return Error::Truncated; }
+
+                const i32 value = parseNumber(word);
+                if (value < 0 or value > 0xFF) { return Error::BadHeader; }
+
+                packed[byte] = reverseBits(static_cast<u8>(value));
+            }
+
+            packed[row_bytes - 1] &= static_cast<u8>(0xFF << (row_bytes * 8 - size.width));
+
+            if ((row & 7) == 7 or row == size.height - 1) {
+                const auto first = static_cast<Pixel>(row & ~7);
+                flushRows(target, x, y, size.width, first, static_cast<Pixel>(row - first + 1));
+                clearRows();
+            }
+        }
+
+        return size;
+    }
+
+    static inline u32 readLe(const u8 *p, u8 bytes) noexcept {
+        u32 value = 0;
+        for (u8 i = bytes; i > 0; --i) { value = (value << 8) | p[i - 1]; }
+        return value;
+    }
+
+    template<typename Read> Result<Size, Error> decodeBmp(Source<Read> &source, const FrameView &target, Pixel x, Pixel y) noexcept {
+        // Заголовок файла (14) и BITMAPINFOHEADER (40)
+        u8 header[54];
+        if (not source.readExact(header, sizeof(header))) { return Error::Truncated; }
+        if (header[0] != 'B' or header[1] != 'M') { return Error::BadHeader; }
+
+        const u32 data_offset = readLe(header + 10, 4);
+        const u32 info_size = readLe(header + 14, 4);
+        const auto width = static_cast<i32>(readLe(header + 18, 4));
+        const auto raw_height = static_cast<i32>(readLe(header + 22, 4));
+        const auto bits = readLe(header + 28, 2);
+        const u32 compression = readLe(header + 30, 4);
+
+        if (info_size < 40) { return Error::Unsupported; }
+        if (bits != 1 or compression != 0) { return Error::Unsupported; }
+
+        const bool top_down = raw_height < 0;
+        const auto size_result = checkSize(width, top_down ? -raw_height : raw_height);
+        if (not size_result.isOk()) { return size_result.error().value(); }
+        const Size size = size_result.ok().value();
+
+        // Палитра из двух цветов BGRA после заголовка
+        if (not source.skip(info_size - 40)) { return Error::Truncated; }
+
+        u8 palette[8];
+        if (not source.readExact(palette, sizeof(palette))) { return Error::Truncated; }
+
+        const usize consumed = sizeof(header) + (info_size - 40) + sizeof(palette);
+        if (data_offset < consumed) { return Error::BadHeader; }
+        if (not source.skip(data_offset - consumed)) { return Error::Truncated; }
+
+        // Включён тёмный цвет: если цвет 1 светлее цвета 0, биты инвертируются
+        const auto luminance = [&palette](u8 index) {
+            const u8 *bgr = palette + index * 4;
+            return bgr[0] * 1 + bgr[1] * 6 + bgr[2] * 3;
+        };
+        const u8 invert = luminance(1) > luminance(0) ? 0xFF : 0x00;
+
+        const usize row_bytes = (size.width + 7) / 8;
+        const usize padding = (4 - row_bytes % 4) % 4;
+        clearRows();
+
+        for (Pixel index = 0; index < size.height; ++index) {
+            // Строки хранятся снизу вверх, если высота положительна
+            const auto row = static_cast<Pixel>(top_down ? index : size.height - 1 - index);
+            u8 *packed = rows[row & 7];
+
+            if (not source.readExact(packed, row_bytes)) { return Error::Truncated; }
+            if (not source.skip(padding)) { return Error::Truncated; }
+
+            for (usize byte = 0; byte < row_bytes; ++byte) { packed[byte] ^= invert; }
+            packed[row_bytes - 1] &= static_cast<u8>(0xFF << (row_bytes * 8 - size.width));
+
+            const bool strip_done = top_down
+                                        ? ((row & 7) == 7 or row == size.height - 1)
+                                        : ((row & 7) == 0);
+
+            if (strip_done) {
+                const auto first = static_cast<Pixel>(row & ~7);
+                const auto count = static_cast<Pixel>(std::min(8, size.height - first));
+                flushRows(target, x, y, size.width, first, count);
+                clearRows();
+            }
+        }
+
+        return size;
+    }
+};
+
+}// namespace kf::gfx
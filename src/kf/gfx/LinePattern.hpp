@@ -0,0 +1,85 @@
+#pragma once
+
+#include <kf/units.hpp>
+
+
+namespace kf::gfx {
+
+/// @brief Шаблон штриховки линии
+/// @details Бит i шаблона - пиксель i периода. Позиция в шаблоне привязана к координате
+/// области (X для горизонтальных и пологих линий, Y для вертикальных и крутых), поэтому
+/// штрихи линий сетки совпадают и не зависят от направления рисования
+struct LinePattern final {
+
+    /// @brief Наибольшая длина периода (бит в bits)
+    static constexpr u8 max_length = 32;
+
+    /// @brief Биты периода
+    u32 bits;
+
+    /// @brief Длина периода (1-32, больше - как 32, см. period())
+    u8 length;
+
+    /// @brief Сдвиг шаблона
+    u8 phase;
+
+    /// @brief Сплошная линия
+    [[nodiscard]] static constexpr LinePattern solid() noexcept {
+        return LinePattern{0xFFFFFFFFu, 32, 0};
+    }
+
+    /// @brief Штрих dash пикселей, пробел gap пикселей
+    /// @details Штрих ограничивается 32 пикселями, пробел - остатком до 32
+    [[nodiscard]] static constexpr LinePattern dashed(u8 dash, u8 gap, u8 phase = 0) noexcept {
+        if (dash > max_length) { dash = max_length; }
+        if (gap > max_length - dash) { gap = static_cast<u8>(max_length - dash); }
+        return LinePattern{dash >= max_length ? 0xFFFFFFFFu : (1u << dash) - 1, static_cast<u8>(dash + gap), phase};
+    }
+
+    /// @brief Точка через каждые step пикселей
+    /// @details step ограничивается 32
+    [[nodiscard]] static constexpr LinePattern dotted(u8 step = 2, u8 phase = 0) noexcept {
+        return LinePattern{1u, step > max_length ? max_length : step, phase};
+    }
+
+    /// @brief Длина периода, ограниченная max_length
+    /// @details Шаблон может прийти извне (поток команд) с любой длиной, сдвиг bits на 32 и больше не определён
+    [[nodiscard]] constexpr u8 period() const noexcept { return length > max_length ? max_length : length; }
+
+    /// @brief Смещение координаты в периоде
+    [[nodiscard]] constexpr u8 offset(Pixel position) const noexcept {
+        const u8 size = period();
+        if (size == 0) { return 0; }
+
+        const i32 remainder = (position + phase) % size;
+        return static_cast<u8>(remainder < 0 ? remainder + size : remainder);
+    }
+
+    /// @brief Пиксель в координате position включён
+    [[nodiscard]] constexpr bool at(Pixel position) const noexcept {
+        return (bits >> offset(position)) & 1;
+    }
+
+    /// @brief Период, повторённый не менее чем на 40 бит
+    /// @details (tile() >> offset) & 0xFF - 8 пикселей подряд с любого смещения периода
+    [[nodiscard]] constexpr u64 tile() const noexcept {
+        const u8 size = period();
+        if (size == 0) { return 0; }
+
+        // Удвоение повторов: не более 5 сдвигов
+        u64 result = size >= max_length ? bits : bits & ((1u << size) - 1);
+        for (u8 span = size; span < 40; span = static_cast<u8>(span * 2)) {
+            result |= result << span;
+        }
+        return result;
+    }
+
+    /// @brief Смещение в периоде через 8 пикселей
+    /// @param step 8 % length
+    [[nodiscard]] constexpr u8 advance(u8 offset, u8 step) const noexcept {
+        offset = static_cast<u8>(offset + step);
+        return offset >= period() ? static_cast<u8>(offset - period()) : offset;
+    }
+};
+
+}// namespace kf::gfx
@@ -0,0 +1,67 @@
+#pragma once
+
+#if defined(__unix__) or defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <kf/units.hpp>
+
+
+namespace kf::gfx {
+
+/// @brief Файл, отображённый в память только для чтения (POSIX)
+/// @details Позволяет проигрывать ресурсы (например, анимации) с диска без копирования
+struct MappedFile final {
+
+private:
+    /// @brief Отображённые данные
+    const u8 *mapped{nullptr};
+
+    /// @brief Размер файла
+    usize mapped_size{0};
+
+public:
+    /// @brief Отобразить файл
+    /// @details При ошибке isOpen() == false
+    explicit MappedFile(const char *path) noexcept {
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) { return; }
+
+        struct stat info {};
+        if (::fstat(fd, &info) == 0 and info.st_size > 0) {
+            void *address = ::mmap(nullptr, static_cast<usize>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (address != MAP_FAILED) {
+                mapped = static_cast<const u8 *>(address);
+                mapped_size = static_cast<usize>(info.st_size);
+            }
+        }
+
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile() {
+        if (nullptr != mapped) {
+            ::munmap(const_cast<u8 *>(mapped), mapped_size);
+        }
+    }
+
+    /// @brief Файл успешно отображён
+    [[nodiscard]] inline bool isOpen() const noexcept { return nullptr != mapped; }
+
+    /// @brief Данные файла
+    [[nodiscard]] inline const u8 *data() const noexcept { return mapped; }
+
+    /// @brief Размер файла
+    [[nodiscard]] inline usize size() const noexcept { return mapped_size; }
+};
+
+}// namespace kf::gfx
+
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <kf/units.hpp>
+
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Морфологические операции над областью дисплея (окно 3x3)
+/// @details Выполняются на месте в два прохода: по столбцам (сдвиги байта страницы с переносом
+/// из соседних страниц), затем по страницам (OR/AND соседних столбцов, хранимых в регистрах).
+/// Пиксели вне области считаются выключенными и не изменяются
+namespace morphology {
+
+/// @brief Расширение столбца битов на строку вверх и вниз
+[[nodiscard]] inline constexpr u16 dilateBits(u16 bits) noexcept {
+    return static_cast<u16>(bits | (bits << 1) | (bits >> 1));
+}
+
+/// @brief Проход по столбцам: строка объединяется (OR) или пересекается (AND) с соседними строками
+template<bool Dilate> void verticalPass(const FrameView &area) noexcept {
+    const auto first_page = static_cast<Pixel>(area.offset_y >> 3);
+    const auto last_page = static_cast<Pixel>((area.offset_y + area.height - 1) >> 3);
+
+    // Неполными могут быть только крайние страницы
+    const u8 first_mask = area.calculatePageMask(first_page);
+    const u8 last_mask = area.calculatePageMask(last_page);
+    const auto maskOf = [=](Pixel page) -> u8 {
+        if (page == first_page) { return first_mask; }
+        return page == last_page ? last_mask : 0xFF;
+    };
+
+    for (Pixel x = 0; x < area.width; ++x) {
+        const Pixel abs_x = area.toAbsoluteX(x);
+
+        u8 previous = 0;
+        u8 current = area.readData(abs_x, first_page) & first_mask;
+
+        for (Pixel page = first_page; page <= last_page; ++page) {
+            const auto next_page = static_cast<Pixel>(page + 1);
+            const u8 next = page < last_page ? area.readData(abs_x, next_page) & maskOf(next_page) : 0;
+
+            // Соседи сверху и снизу с переносом через границу страницы
+            const auto above = static_cast<u8>((current << 1) | (previous >> 7));
+            const auto below = static_cast<u8>((current >> 1) | (next << 7));
+            const u8 result = Dilate ? (current | above | below) : (current & above & below);
+
+            area.writeMaskedData(abs_x, page, result, maskOf(page));
+
+            previous = current;
+            current = next;
+        }
+    }
+}
+
+/// @brief Проход по страницам: столбец объединяется (OR) или пересекается (AND) с соседними столбцами
+template<bool Dilate> void horizontalPass(const FrameView &area) noexcept {
+    const auto first_page = static_cast<Pixel>(area.offset_y >> 3);
+    const auto last_page = static_cast<Pixel>((area.offset_y + area.height - 1) >> 3);
+    const Pixel first_x = area.toAbsoluteX(0);
+    const Pixel last_x = area.toAbsoluteX(static_cast<Pixel>(area.width - 1));
+
+    for (Pixel page = first_page; page <= last_page; ++page) {
+        const u8 mask = area.calculatePageMask(page);
+
+        u8 left = 0;
+        u8 current = area.readData(first_x, page) & mask;
+
+        for (Pixel abs_x = first_x; abs_x <= last_x; ++abs_x) {
+            const u8 right = abs_x < last_x ? area.readData(static_cast<Pixel>(abs_x + 1), page) & mask : 0;
+            const u8 result = Dilate ? (left | current | right) : (left & current & right);
+
+            area.writeMaskedData(abs_x, page, result, mask);
+
+            left = current;
+            current = right;
+        }
+    }
+}
+
+/// @brief Расширение: пиксель включается, если включён он или любой из 8 соседей
+inline void dilate(const FrameView &area) noexcept {
+    if (not area.isValid() or area.width < 1 or area.height < 1) { return; }
+
+    verticalPass<true>(area);
+    horizontalPass<true>(area);
+}
+
+/// @brief Сужение: пиксель остаётся включённым, только если включены он и все 8 соседей
+inline void erode(const FrameView &area) noexcept {
+    if (not area.isValid() or area.width < 1 or area.height < 1) { return; }
+
+    verticalPass<false>(area);
+    horizontalPass<false>(area);
+}
+
+}// namespace morphology
+}// namespace kf::gfx
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <kf/units.hpp>
+
+#include "kf/gfx/Bezier.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Правило заливки пути
+enum class FillRule : u8 {
+
+    /// @brief Чётное число пересечений - снаружи
+    EvenOdd,
+
+    /// @brief Ненулевое число обходов - внутри
+    NonZero,
+};
+
+/// @brief Контур пути
+struct PathContour final {
+
+    /// @brief Индекс точки после последней точки контура
+    u16 end;
+
+    /// @brief Контур замкнут
+    bool closed;
+};
+
+/// @brief Представление пути с размерами, известными во время выполнения
+struct PathView final {
+
+    /// @brief Вершины (Q8)
+    const bezier::Point *points;
+
+    /// @brief Количество вершин
+    u16 points_count;
+
+    /// @brief Контуры
+    const PathContour *contours;
+
+    /// @brief Количество контуров
+    u8 contours_count;
+};
+
+/// @brief Путь из отрезков и кривых Безье с фиксированной ёмкостью
+/// @details Кривые разбиваются на отрезки при добавлении, вершины хранятся в Q8.
+/// При нехватке места добавление прекращается, путь остаётся корректным префиксом
+/// @tparam Capacity Максимум вершин
+/// @tparam Contours Максимум контуров
+template<u16 Capacity, u8 Contours = 4> struct Path final {
+
+    static_assert(Capacity >= 2 and Contours >= 1);
+
+private:
+    /// @brief Вершины
+    bezier::Point points[Capacity]{};
+
+    /// @brief Контуры
+    PathContour contours[Contours]{};
+
+    /// @brief Количество вершин
+    u16 points_count{0};
+
+    /// @brief Количество контуров
+    u8 contours_count{0};
+
+    /// @brief Вершины или контуры не поместились
+    bool overflow{false};
+
+public:
+    /// @brief Допуск разбиения кривых, Q8
+    i32 tolerance{bezier::default_tolerance};
+
+    /// @brief Очистить путь
+    void clear() noexcept {
+        points_count = 0;
+        contours_count = 0;
+        overflow = false;
+    }
+
+    /// @brief Начать новый контур
+    void moveTo(Pixel x, Pixel y) noexcept {
+        if (overflow or contours_count == Contours) {
+            overflow = true;
+            return;
+        }
+
+        contours[contours_count++] = PathContour{points_count, false};
+        add(bezier::fromPixels(x, y));
+    }
+
+    /// @brief Отрезок до точки
+    void lineTo(Pixel x, Pixel y) noexcept {
+        add(bezier::fromPixels(x, y));
+    }
+
+    /// @brief Квадратичная кривая с контрольной точкой (cx, cy)
+    void quadTo(Pixel cx, Pixel cy, Pixel x, Pixel y) noexcept {
+        if (not started()) { return; }
+
+        bezier::quadratic(
+            points[points_count - 1],
+            bezier::fromPixels(cx, cy),
+            bezier::fromPixels(x, y),
+            [this](bezier::Point p) { add(p); },
+            tolerance);
+    }
+
+    /// @brief Кубическая кривая с контрольными точками (c1x, c1y), (c2x, c2y)
+    void cubicTo(Pixel c1x, Pixel c1y, Pixel c2x, Pixel c2y, Pixel x, Pixel y) noexcept {
+        if (not started()) { return; }
+
+        bezier::cubic(
+            points[points_count - 1],
+            bezier::fromPixels(c1x, c1y),
+            bezier::fromPixels(c2x, c2y),
+            bezier::fromPixels(x, y),
+            [this](bezier::Point p) { add(p); },
+            tolerance);
+    }
+
+    /// @brief Замкнуть текущий контур
+    void close() noexcept {
+        if (contours_count != 0) { contours[contours_count - 1].closed = true; }
+    }
+
+    /// @brief Количество вершин
+    [[nodiscard]] inline u16 size() const noexcept { return points_count; }
+
+    /// @brief Путь не поместился
+    [[nodiscard]] inline bool overflowed() const noexcept { return overflow; }
+
+    /// @brief Представление пути
+    [[nodiscard]] PathView view() const noexcept {
+        return PathView{points, points_count, contours, contours_count};
+    }
+
+private:
+    /// @brief Контур начат
+    [[nodiscard]] bool started() const noexcept {
+        return contours_count != 0 and points_count != 0 and not overflow;
+    }
+
+    /// @brief Добавить вершину в текущий контур
+    void add(bezier::Point point) noexcept {
+        if (contours_count == 0) { return; }
+        if (overflow or points_count == Capacity) {
+            overflow = true;
+            return;
+        }
+
+        points[points_count++] = point;
+        contours[contours_count - 1].end = points_count;
+    }
+};
+
+}// namespace kf::gfx
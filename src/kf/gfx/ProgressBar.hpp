@@ -0,0 +1,309 @@
+#pragma once
+
+#include <algorithm>
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/Font.hpp"
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Полоса прогресса или ползунок
+/// @details Внутренняя область - закрашенный интервал столбцов (от начала до значения у полосы,
+/// бегунок у ползунка) и пустые столбцы (у ползунка - с линией дорожки). render() перерисовывает
+/// только столбцы между старыми и новыми границами интервала
+/// @details Текст поверх полосы накладывается через XOR: столбец записывается целиком и затем
+/// инвертируется глифом, поэтому текст читается и на закрашенной, и на пустой части без полной перерисовки
+struct ProgressBar final {
+
+    /// @brief Вид
+    enum class Style : u8 {
+
+        /// @brief Полоса, закрашенная от начала до значения
+        Bar,
+
+        /// @brief Бегунок на дорожке
+        Slider,
+    };
+
+    /// @brief Ошибки
+    enum class Error : u8 {
+
+        /// @brief Размер мал для рамки или нулевой максимум
+        BadGeometry,
+    };
+
+    /// @brief Максимальная длина текста
+    static constexpr u8 text_capacity = 8;
+
+private:
+    /// @brief Ширина
+    Pixel width;
+
+    /// @brief Высота
+    Pixel height;
+
+    /// @brief Значение полной полосы
+    u16 max_value;
+
+    /// @brief Вид
+    Style style;
+
+    /// @brief Рамка
+    bool border;
+
+    /// @brief Значение закрашенных пикселей
+    bool on;
+
+    /// @brief Значение
+    u16 value{0};
+
+    /// @brief Закрашенный интервал на экране [begin, end), в столбцах виджета
+    Pixel shown_begin{0}, shown_end{0};
+
+    /// @brief Текст
+    char text[text_capacity + 1]{};
+
+    /// @brief Столбцы текста на экране [begin, end)
+    Pixel shown_text_begin{0}, shown_text_end{0};
+
+    /// @brief Текст изменился
+    bool text_changed{false};
+
+    /// @brief Положение на экране
+    Pixel last_x{0}, last_y{0};
+
+    /// @brief Перерисовать всё
+    bool redraw_all{true};
+
+public:
+    /// @brief Шрифт текста (nullptr - без текста)
+    const Font *font{nullptr};
+
+    /// @brief Показывать процент значения как текст
+    bool percent_text{false};
+
+    /// @brief Создать полосу
+    /// @param max_value Значение полной полосы
+    /// @param border Рамка толщиной в пиксель и отступ в пиксель
+    [[nodiscard]] static Result<ProgressBar, Error> create(
+        Pixel width,
+        Pixel height,
+        u16 max_value = 100,
+        Style style = Style::Bar,
+        bool border = true,
+        bool on = true) noexcept {
+        const Pixel inset = border ? 4 : 0;
+        if (width <= inset or height <= inset or max_value == 0) { return Error::BadGeometry; }
+        return ProgressBar{width, height, max_value, style, border, on};
+    }
+
+    /// @brief Установить значение (ограничивается max_value)
+    void set(u16 new_value) noexcept {
+        value = std::min(new_value, max_value);
+        if (percent_text) { formatPercent(); }
+    }
+
+    /// @brief Значение
+    [[nodiscard]] inline u16 get() const noexcept { return value; }
+
+    /// @brief Установить текст (обрезается до text_capacity символов)
+    void setText(const char *new_text) noexcept {
+        u8 i = 0;
+        for (; nullptr != new_text and new_text[i] != '\0' and i < text_capacity; ++i) {
+            if (text[i] != new_text[i]) { text_changed = true; }
+            text[i] = new_text[i];
+        }
+        if (text[i] != '\0') { text_changed = true; }
+        text[i] = '\0';
+    }
+
+    /// @brief Перерисовать всё при следующем render()
+    void invalidate() noexcept { redraw_all = true; }
+
+    /// @brief Обновить виджет на экране
+    /// @param x, y Левый верхний угол
+    /// @details Смена положения перерисовывает всё
+    /// @returns Количество перерисованных столбцов
+    usize render(const FrameView &target, Pixel x, Pixel y) noexcept {
+        if (not target.isValid()) { return 0; }
+
+        if (x != last_x or y != last_y) {
+            last_x = x;
+            last_y = y;
+            redraw_all = true;
+        }
+
+        Pixel begin, end;
+        solidRange(begin, end);
+
+        Pixel text_begin = 0, text_end = 0;
+        textRange(text_begin, text_end);
+
+        usize drawn = 0;
+
+        if (redraw_all) {
+            if (border) { drawBorder(target, x, y); }
+            drawn += drawColumns(target, x, y, inner(), static_cast<Pixel>(width - inner()), begin, end, text_begin, text_end);
+        } else {
+            // Столбцы, сменившие закраску: между старыми и новыми границами интервала
+            drawn += drawColumns(target, x, y, std::min(shown_begin, begin), std::max(shown_begin, begin), begin, end, text_begin, text_end);
+            drawn += drawColumns(target, x, y, std::min(shown_end, end), std::max(shown_end, end), begin, end, text_begin, text_end);
+
+            // Текст центрирован: старые и новые столбцы текста перекрываются, перерисовывается объединение
+            if (text_changed) {
+                auto first = std::min(shown_text_begin, text_begin);
+                auto last = std::max(shown_text_end, text_end);
+                if (shown_text_begin == shown_text_end) {
+                    first = text_begin;
+                    last = text_end;
+                } else if (text_begin == text_end) {
+                    first = shown_text_begin;
+                    last = shown_text_end;
+                }
+                drawn += drawColumns(target, x, y, first, last, begin, end, text_begin, text_end);
+            }
+        }
+
+        shown_begin = begin;
+        shown_end = end;
+        shown_text_begin = text_begin;
+        shown_text_end = text_end;
+        text_changed = false;
+        redraw_all = false;
+        return drawn;
+    }
+
+private:
+    ProgressBar(Pixel width, Pixel height, u16 max_value, Style style, bool border, bool on) noexcept :
+        width{width}, height{height}, max_value{max_value}, style{style}, border{border}, on{on} {}
+
+    /// @brief Отступ внутренней области
+    [[nodiscard]] inline Pixel inner() const noexcept { return border ? 2 : 0; }
+
+    /// @brief Закрашенный интервал столбцов для текущего значения
+    void solidRange(Pixel &begin, Pixel &end) const noexcept {
+        const Pixel left = inner();
+        const auto span = static_cast<Pixel>(width - 2 * left);
+
+        if (style == Style::Bar) {
+            begin = left;
+            end = static_cast<Pixel>(left + static_cast<u32>(span) * value / max_value);
+            return;
+        }
+
+        // Бегунок квадратный по высоте внутренней области, не шире половины дорожки
+        const auto thumb = static_cast<Pixel>(std::max(1, std::min(height - 2 * left, span / 2)));
+        begin = static_cast<Pixel>(left + static_cast<u32>(span - thumb) * value / max_value);
+        end = static_cast<Pixel>(begin + thumb);
+    }
+
+    /// @brief Столбцы текста (по центру)
+    void textRange(Pixel &begin, Pixel &end) const noexcept {
+        u8 length = 0;
+        while (text[length] != '\0') { length += 1; }
+        if (nullptr == font or length == 0) { return; }
+
+        const auto text_width = static_cast<Pixel>(length * font->widthTotal() - 1);
+        begin = static_cast<Pixel>(std::max(inner(), static_cast<Pixel>((width - text_width) / 2)));
+        end = static_cast<Pixel>(std::min(static_cast<Pixel>(begin + text_width), static_cast<Pixel>(width - inner())));
+    }
+
+    /// @brief Текст процента значения
+    void formatPercent() noexcept {
+        const u32 percent = (static_cast<u32>(value) * 100 + max_value / 2) / max_value;
+        char buffer[5];
+        u8 length = 0;
+
+        if (percent >= 100) { buffer[length++] = '1'; }
+        if (percent >= 10) { buffer[length++] = static_cast<char>('0' + percent / 10 % 10); }
+        buffer[length++] = static_cast<char>('0' + percent % 10);
+        buffer[length++] = '%';
+        buffer[length] = '\0';
+
+        setText(buffer);
+    }
+
+    /// @brief Рамка и отступ
+    void drawBorder(const FrameView &target, Pixel x, Pixel y) const noexcept {
+        const auto right = static_cast<Pixel>(x + width - 1);
+        const auto bottom = static_cast<Pixel>(y + height - 1);
+
+        target.drawHorizontalSpan(x, right, y, on);
+        target.drawHorizontalSpan(x, right, bottom, on);
+        target.drawVerticalSpan(x, y, bottom, on);
+        target.drawVerticalSpan(right, y, bottom, on);
+
+        target.drawHorizontalSpan(static_cast<Pixel>(x + 1), static_cast<Pixel>(right - 1), static_cast<Pixel>(y + 1), not on);
+        target.drawHorizontalSpan(static_cast<Pixel>(x + 1), static_cast<Pixel>(right - 1), static_cast<Pixel>(bottom - 1), not on);
+        target.drawVerticalSpan(static_cast<Pixel>(x + 1), static_cast<Pixel>(y + 1), static_cast<Pixel>(bottom - 1), not on);
+        target.drawVerticalSpan(static_cast<Pixel>(right - 1), static_cast<Pixel>(y + 1), static_cast<Pixel>(bottom - 1), not on);
+    }
+
+    /// @brief Перерисовать столбцы [first, last) внутренней области
+    /// @returns Количество столбцов
+    usize drawColumns(
+        const FrameView &target,
+        Pixel x,
+        Pixel y,
+        Pixel first,
+        Pixel last,
+        Pixel begin,
+        Pixel end,
+        Pixel text_begin,
+        Pixel text_end) const noexcept {
+        const Pixel top = inner();
+        const auto bottom = static_cast<Pixel>(height - inner());
+        const auto track = static_cast<Pixel>((top + bottom) / 2);
+
+        const u8 glyph_width = nullptr == font ? 0 : font->glyph_width;
+        const u8 glyph_step = nullptr == font ? 1 : font->widthTotal();
+        const auto text_top = static_cast<Pixel>(nullptr == font ? 0 : (height - font->glyph_height) / 2);
+
+        // Строки глифа, попадающие во внутреннюю область
+        u16 glyph_mask = 0;
+        for (u8 i = 0; nullptr != font and i < font->glyph_height; ++i) {
+            const auto row = static_cast<Pixel>(text_top + i);
+            if (row >= top and row < bottom) { glyph_mask = static_cast<u16>(glyph_mask | (1u << i)); }
+        }
+
+        for (Pixel column = first; column < last; ++column) {
+            const bool solid = column >= begin and column < end;
+            const auto screen_x = static_cast<Pixel>(x + column);
+
+            // Столбец внутренней области полосами до 16 строк
+            for (Pixel row = top; row < bottom; row = static_cast<Pixel>(row + 16)) {
+                const auto rows = static_cast<u8>(std::min(16, bottom - row));
+                const auto mask = static_cast<u16>((1u << rows) - 1);
+
+                u16 bits = 0;
+                if (solid) {
+                    bits = mask;
+                } else if (style == Style::Slider and track >= row and track < row + rows) {
+                    bits = static_cast<u16>(1u << (track - row));
+                }
+
+                target.writeColumn(screen_x, static_cast<Pixel>(y + row), on ? bits : static_cast<u16>(~bits), mask);
+            }
+
+            // Глиф текста через XOR
+            if (column < text_begin or column >= text_end) { continue; }
+
+            const auto offset = static_cast<u16>(column - text_begin);
+            const auto glyph_column = static_cast<u8>(offset % glyph_step);
+            if (glyph_column >= glyph_width) { continue; }
+
+            const u8 *glyph = font->getGlyph(text[offset / glyph_step]);
+            if (nullptr == glyph) { continue; }
+
+            target.writeColumn(screen_x, static_cast<Pixel>(y + text_top), glyph[glyph_column], glyph_mask, FrameView::RasterOp::Xor);
+        }
+
+        return static_cast<usize>(std::max(0, last - first));
+    }
+};
+
+}// namespace kf::gfx
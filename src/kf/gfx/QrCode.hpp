@@ -0,0 +1,597 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief QR-код версий 1-10 в байтовом режиме
+/// @details Модули хранятся по столбцам: бит y слова столбца x - модуль (x, y).
+/// При отрисовке столбец модулей растягивается в столбец пикселей по 16 строк
+/// и записывается scale раз маской через FrameView::writeColumn
+/// @details Все буферы внутри объекта, динамическая память не используется
+struct QrCode final {
+
+    /// @brief Уровень коррекции ошибок
+    enum class Ecc : u8 {
+
+        /// @brief ~7% кодовых слов
+        Low,
+
+        /// @brief ~15% кодовых слов
+        Medium,
+
+        /// @brief ~25% кодовых слов
+        Quartile,
+
+        /// @brief ~30% кодовых слов
+        High,
+    };
+
+    /// @brief Ошибки
+    enum class Error : u8 {
+
+        /// @brief Данные не помещаются в версию 10 с выбранной коррекцией
+        TooLong,
+    };
+
+    /// @brief Максимальная версия
+    static constexpr u8 max_version = 10;
+
+    /// @brief Максимальный размер в модулях
+    static constexpr Pixel max_size = 17 + 4 * max_version;
+
+    /// @brief Рекомендуемая ширина свободной зоны в модулях
+    static constexpr u8 quiet_zone = 4;
+
+    /// @brief Выбрать маску с наименьшим штрафом
+    static constexpr u8 auto_mask = 8;
+
+private:
+    /// @brief Кодовых слов в версии 10
+    static constexpr usize max_codewords = 346;
+
+    /// @brief Кодовых слов коррекции на блок
+    static constexpr u8 ecc_per_block[4][max_version + 1] = {
+        {0, 7, 10, 15, 20, 26, 18, 20, 24, 30, 18},
+        {0, 10, 16, 26, 18, 24, 16, 18, 22, 22, 26},
+        {0, 13, 22, 18, 26, 18, 24, 18, 22, 20, 24},
+        {0, 17, 28, 22, 16, 22, 28, 26, 26, 24, 28},
+    };
+
+    /// @brief Количество блоков коррекции
+    static constexpr u8 ecc_blocks[4][max_version + 1] = {
+        {0, 1, 1, 1, 1, 1, 2, 2, 2, 2, 4},
+        {0, 1, 1, 1, 2, 2, 4, 4, 4, 5, 5},
+        {0, 1, 1, 2, 2, 4, 4, 6, 6, 8, 8},
+        {0, 1, 1, 2, 4, 4, 4, 5, 6, 8, 8},
+    };
+
+    /// @brief Модули (1 - тёмный), по столбцам
+    u64 modules[max_size]{};
+
+    /// @brief Служебные модули (не заняты данными), по столбцам
+    u64 functions[max_size]{};
+
+    /// @brief Кодовые слова данных, затем коррекции по блокам
+    u8 codewords[max_codewords]{};
+
+    /// @brief Версия (0 - не закодировано)
+    u8 current_version{0};
+
+    /// @brief Уровень коррекции
+    Ecc current_ecc{Ecc::Low};
+
+public:
+    /// @brief Закодировать данные в наименьшую подходящую версию
+    /// @param mask Маска 0..7 или auto_mask
+    /// @returns Версия
+    Result<u8, Error> encode(const u8 *data, usize size, Ecc ecc = Ecc::Medium, u8 mask = auto_mask) noexcept {
+        u8 version = 1;
+        for (; version <= max_version; ++version) {
+            const usize needed = 4 + countBits(version) + 8 * size;
+            if (needed <= dataCodewords(version, ecc) * 8u) { break; }
+        }
+        if (version > max_version) { return Error::TooLong; }
+
+        current_version = version;
+        current_ecc = ecc;
+
+        writeData(data, size);
+        writeEcc();
+
+        std::memset(modules, 0, sizeof(modules));
+        std::memset(functions, 0, sizeof(functions));
+        drawFunctionPatterns();
+        drawCodewords();
+
+        if (mask >= auto_mask) { mask = bestMask(); }
+        applyMask(mask);
+        drawFormatBits(mask);
+
+        return version;
+    }
+
+    /// @brief Закодировать строку
+    Result<u8, Error> encode(const char *text, Ecc ecc = Ecc::Medium, u8 mask = auto_mask) noexcept {
+        return encode(reinterpret_cast<const u8 *>(text), std::strlen(text), ecc, mask);
+    }
+
+    /// @brief Версия (0 - не закодировано)
+    [[nodiscard]] inline u8 version() const noexcept { return current_version; }
+
+    /// @brief Размер в модулях
+    [[nodiscard]] inline Pixel size() const noexcept { return static_cast<Pixel>(17 + 4 * current_version); }
+
+    /// @brief Тёмный ли модуль
+    [[nodiscard]] inline bool module(Pixel x, Pixel y) const noexcept { return (modules[x] >> y) & 1; }
+
+    /// @brief Сторона изображения в пикселях вместе со свободной зоной
+    [[nodiscard]] inline Pixel pixelSize(u8 scale, u8 quiet = quiet_zone) const noexcept {
+        return static_cast<Pixel>((size() + 2 * quiet) * scale);
+    }
+
+    /// @brief Отрисовать код вместе со свободной зоной
+    /// @param x, y Левый верхний угол свободной зоны
+    /// @param scale Сторона модуля в пикселях
+    /// @param quiet Ширина свободной зоны в модулях
+    /// @param on Значение пикселей тёмных модулей (светлые модули и свободная зона - обратное).
+    /// По умолчанию тёмные модули гасятся: код на OLED выглядит как напечатанный
+    void render(const FrameView &target, Pixel x, Pixel y, u8 scale = 1, u8 quiet = quiet_zone, bool on = false) const noexcept {
+        if (current_version == 0 or scale == 0) { return; }
+
+        const auto columns = static_cast<Pixel>(size() + 2 * quiet);
+        const auto pixels = static_cast<Pixel>(columns * scale);
+
+        for (Pixel column = 0; column < columns; ++column) {
+            const auto module_x = static_cast<Pixel>(column - quiet);
+            const u64 dark = (module_x >= 0 and module_x < size()) ? modules[module_x] : 0;
+            const auto px = static_cast<Pixel>(x + column * scale);
+
+            for (Pixel row = 0; row < pixels; row = static_cast<Pixel>(row + 16)) {
+                auto bits = expandColumn(dark, row, scale, quiet);
+                if (not on) { bits = static_cast<u16>(~bits); }
+
+                const auto rows = static_cast<Pixel>(pixels - row);
+                const auto mask = static_cast<u16>(rows >= 16 ? 0xFFFF : (1u << rows) - 1);
+
+                // Столбцы одного модуля одинаковы
+                for (u8 k = 0; k < scale; ++k) {
+                    target.writeColumn(static_cast<Pixel>(px + k), static_cast<Pixel>(y + row), bits, mask);
+                }
+            }
+        }
+    }
+
+private:
+    /// @brief Бит длины данных байтового режима
+    static constexpr u8 countBits(u8 version) noexcept { return version < 10 ? 8 : 16; }
+
+    /// @brief Количество модулей данных и коррекции
+    static constexpr usize rawModules(u8 version) noexcept {
+        usize result = (16 * version + 128) * version + 64;
+        if (version >= 2) {
+            const usize alignments = version / 7 + 2;
+            result -= (25 * alignments - 10) * alignments - 55;
+            if (version >= 7) { result -= 36; }
+        }
+        return result;
+    }
+
+    /// @brief Количество кодовых слов данных
+    static constexpr usize dataCodewords(u8 version, Ecc ecc) noexcept {
+        const auto level = static_cast<u8>(ecc);
+        return rawModules(version) / 8 - ecc_per_block[level][version] * ecc_blocks[level][version];
+    }
+
+    /// @brief Степени и логарифмы GF(256) по модулю x^8 + x^4 + x^3 + x^2 + 1
+    struct Galois final {
+
+        /// @brief 2^i, продублированы для суммы двух логарифмов
+        u8 exp[510];
+
+        /// @brief log2(i), log[0] не используется
+        u8 log[256];
+
+        constexpr Galois() noexcept :
+            exp{}, log{} {
+            u16 value = 1;
+            for (u16 i = 0; i < 255; ++i) {
+                exp[i] = exp[i + 255] = static_cast<u8>(value);
+                log[value] = static_cast<u8>(i);
+                value = static_cast<u16>(value << 1);
+                if (value & 0x100) { value ^= 0x11D; }
+            }
+        }
+
+        [[nodiscard]] constexpr u8 multiply(u8 a, u8 b) const noexcept {
+            return (a == 0 or b == 0) ? 0 : exp[log[a] + log[b]];
+        }
+    };
+
+    [[nodiscard]] static const Galois &galois() noexcept {
+        static constexpr Galois table{};
+        return table;
+    }
+
+    /// @brief Количество единичных бит
+    static constexpr u8 countOnes(u64 value) noexcept {
+        value -= (value >> 1) & 0x5555555555555555;
+        value = (value & 0x3333333333333333) + ((value >> 2) & 0x3333333333333333);
+        value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0F;
+        return static_cast<u8>((value * 0x0101010101010101) >> 56);
+    }
+
+    inline void setFunction(Pixel x, Pixel y, bool dark) noexcept {
+        const u64 bit = u64{1} << y;
+        modules[x] = dark ? (modules[x] | bit) : (modules[x] & ~bit);
+        functions[x] |= bit;
+    }
+
+    /// @brief Режим, длина, данные, терминатор и заполнение
+    void writeData(const u8 *data, usize size) noexcept {
+        const usize capacity = dataCodewords(current_version, current_ecc);
+        std::memset(codewords, 0, sizeof(codewords));
+
+        usize bit = 0;
+        const auto append = [this, &bit](u32 value, u8 count) {
+            for (u8 i = count; i > 0; --i, ++bit) {
+                if ((value >> (i - 1)) & 1) { codewords[bit >> 3] |= static_cast<u8>(0x80 >> (bit & 7)); }
+            }
+        };
+
+        append(0b0100, 4);
+        append(static_cast<u32>(size), countBits(current_version));
+        for (usize i = 0; i < size; ++i) { append(data[i], 8); }
+
+        // Терминатор (до 4 нулевых бит) и выравнивание до байта уже нулевые
+        for (usize i = (bit + 7) / 8, pad = 0; i < capacity; ++i, ++pad) {
+            codewords[i] = (pad & 1) ? 0x11 : 0xEC;
+        }
+    }
+
+    /// @brief Коды Рида-Соломона для каждого блока
+    void writeEcc() noexcept {
+        const auto level = static_cast<u8>(current_ecc);
+        const u8 degree = ecc_per_block[level][current_version];
+        const u8 blocks = ecc_blocks[level][current_version];
+        const usize data_total = dataCodewords(current_version, current_ecc);
+        const Galois &gf = galois();
+
+        // Порождающий многочлен (x - 1)(x - 2)...(x - 2^(degree - 1)), старший коэффициент опущен
+        u8 divisor[30]{};
+        divisor[degree - 1] = 1;
+        for (u8 i = 0; i < degree; ++i) {
+            for (u8 j = 0; j < degree; ++j) {
+                divisor[j] = gf.multiply(divisor[j], gf.exp[i]);
+                if (j + 1 < degree) { divisor[j] ^= divisor[j + 1]; }
+            }
+        }
+
+        for (u8 block = 0; block < blocks; ++block) {
+            const u8 *data = codewords + blockStart(block);
+            const usize length = blockLength(block);
+            u8 *remainder = codewords + data_total + block * degree;
+
+            std::memset(remainder, 0, degree);
+            for (usize i = 0; i < length; ++i) {
+                const u8 factor = data[i] ^ remainder[0];
+                std::memmove(remainder, remainder + 1, degree - 1);
+                remainder[degree - 1] = 0;
+                if (factor == 0) { continue; }
+
+                const u8 factor_log = gf.log[factor];
+                for (u8 j = 0; j < degree; ++j) {
+                    if (divisor[j] != 0) { remainder[j] ^= gf.exp[gf.log[divisor[j]] + factor_log]; }
+                }
+            }
+        }
+    }
+
+    /// @brief Количество коротких блоков (длинные на 1 слово данных больше)
+    [[nodiscard]] usize shortBlocks() const noexcept {
+        const u8 blocks = ecc_blocks[static_cast<u8>(current_ecc)][current_version];
+        return blocks - (rawModules(current_version) / 8) % blocks;
+    }
+
+    /// @brief Слов данных в коротком блоке
+    [[nodiscard]] usize shortBlockData() const noexcept {
+        const auto level = static_cast<u8>(current_ecc);
+        return (rawModules(current_version) / 8) / ecc_blocks[level][current_version] - ecc_per_block[level][current_version];
+    }
+
+    [[nodiscard]] usize blockStart(u8 block) const noexcept {
+        const usize shorts = shortBlocks();
+        return block * shortBlockData() + (block > shorts ? block - shorts : 0);
+    }
+
+    [[nodiscard]] usize blockLength(u8 block) const noexcept { return shortBlockData() + (block >= shortBlocks() ? 1 : 0); }
+
+    /// @brief Кодовое слово в порядке чередования блоков
+    [[nodiscard]] u8 interleaved(usize index) const noexcept {
+        const auto level = static_cast<u8>(current_ecc);
+        const u8 blocks = ecc_blocks[level][current_version];
+        const usize data_total = dataCodewords(current_version, current_ecc);
+
+        if (index >= data_total) {
+            index -= data_total;
+            const usize block = index % blocks;
+            return codewords[data_total + block * ecc_per_block[level][current_version] + index / blocks];
+        }
+
+        // Слова коротких блоков идут по кругу, затем последние слова длинных блоков
+        const usize round = shortBlockData() * blocks;
+        if (index < round) { return codewords[blockStart(static_cast<u8>(index % blocks)) + index / blocks]; }
+
+        const auto block = static_cast<u8>(shortBlocks() + index - round);
+        return codewords[blockStart(block) + shortBlockData()];
+    }
+
+    void drawFunctionPatterns() noexcept {
+        const Pixel n = size();
+
+        // Синхронизация
+        for (Pixel i = 0; i < n; ++i) {
+            setFunction(6, i, i % 2 == 0);
+            setFunction(i, 6, i % 2 == 0);
+        }
+
+        // Поисковые узоры с разделителями
+        drawFinder(3, 3);
+        drawFinder(static_cast<Pixel>(n - 4), 3);
+        drawFinder(3, static_cast<Pixel>(n - 4));
+
+        // Выравнивающие узоры
+        if (current_version >= 2) {
+            Pixel positions[3];
+            const u8 count = static_cast<u8>(current_version / 7 + 2);
+            const auto step = static_cast<Pixel>((current_version * 8 + count * 3 + 5) / (count * 4 - 4) * 2);
+            positions[0] = 6;
+            for (u8 i = count - 1; i >= 1; --i) { positions[i] = static_cast<Pixel>(n - 7 - (count - 1 - i) * step); }
+
+            for (u8 i = 0; i < count; ++i) {
+                for (u8 j = 0; j < count; ++j) {
+                    const bool corner = (i == 0 and j == 0) or (i == 0 and j == count - 1) or (i == count - 1 and j == 0);
+                    if (not corner) { drawAlignment(positions[i], positions[j]); }
+                }
+            }
+        }
+
+        // Место под формат (заполняется после выбора маски)
+        drawFormatBits(0);
+        drawVersion();
+    }
+
+    void drawFinder(Pixel cx, Pixel cy) noexcept {
+        const Pixel n = size();
+        for (Pixel dy = -4; dy <= 4; ++dy) {
+            for (Pixel dx = -4; dx <= 4; ++dx) {
+                const auto x = static_cast<Pixel>(cx + dx);
+                const auto y = static_cast<Pixel>(cy + dy);
+                if (x < 0 or x >= n or y < 0 or y >= n) { continue; }
+
+                const Pixel distance = std::max(dx < 0 ? -dx : dx, dy < 0 ? -dy : dy);
+                setFunction(x, y, distance != 2 and distance != 4);
+            }
+        }
+    }
+
+    void drawAlignment(Pixel cx, Pixel cy) noexcept {
+        for (Pixel dy = -2; dy <= 2; ++dy) {
+            for (Pixel dx = -2; dx <= 2; ++dx) {
+                const Pixel distance = std::max(dx < 0 ? -dx : dx, dy < 0 ? -dy : dy);
+                setFunction(static_cast<Pixel>(cx + dx), static_cast<Pixel>(cy + dy), distance != 1);
+            }
+        }
+    }
+
+    /// @brief Формат: уровень коррекции и маска, код БЧХ (15, 5)
+    void drawFormatBits(u8 mask) noexcept {
+        static constexpr u8 level_bits[4] = {1, 0, 3, 2};
+        const u32 data = static_cast<u32>(level_bits[static_cast<u8>(current_ecc)] << 3 | mask);
+
+        u32 remainder = data;
+        for (u8 i = 0; i < 10; ++i) { remainder = (remainder << 1) ^ ((remainder >> 9) * 0x537); }
+        const u32 bits = (data << 10 | remainder) ^ 0x5412;
+        const auto bit = [bits](u8 i) { return ((bits >> i) & 1) != 0; };
+
+        const Pixel n = size();
+        for (u8 i = 0; i <= 5; ++i) { setFunction(8, i, bit(i)); }
+        setFunction(8, 7, bit(6));
+        setFunction(8, 8, bit(7));
+        setFunction(7, 8, bit(8));
+        for (u8 i = 9; i < 15; ++i) { setFunction(static_cast<Pixel>(14 - i), 8, bit(i)); }
+
+        for (u8 i = 0; i < 8; ++i) { setFunction(static_cast<Pixel>(n - 1 - i), 8, bit(i)); }
+        for (u8 i = 8; i < 15; ++i) { setFunction(8, static_cast<Pixel>(n - 15 + i), bit(i)); }
+        setFunction(8, static_cast<Pixel>(n - 8), true);
+    }
+
+    /// @brief Информация о версии (версии 7+), код Голея (18, 6)
+    void drawVersion() noexcept {
+        if (current_version < 7) { return; }
+
+        u32 remainder = current_version;
+        for (u8 i = 0; i < 12; ++i) { remainder = (remainder << 1) ^ ((remainder >> 11) * 0x1F25); }
+        const u32 bits = static_cast<u32>(current_version) << 12 | remainder;
+
+        for (u8 i = 0; i < 18; ++i) {
+            const bool dark = (bits >> i) & 1;
+            const auto a = static_cast<Pixel>(size() - 11 + i % 3);
+            const auto b = static_cast<Pixel>(i / 3);
+            setFunction(a, b, dark);
+            setFunction(b, a, dark);
+        }
+    }
+
+    /// @brief Размещение кодовых слов зигзагом по парам столбцов снизу вверх и обратно
+    void drawCodewords() noexcept {
+        const Pixel n = size();
+        const usize total_bits = rawModules(current_version) / 8 * 8;
+        usize bit = 0;
+        u8 byte = 0;
+
+        for (Pixel right = static_cast<Pixel>(n - 1); right >= 1; right = static_cast<Pixel>(right - 2)) {
+            if (right == 6) { right = 5; }
+            const bool upward = ((right + 1) & 2) == 0;
+
+            for (Pixel vertical = 0; vertical < n; ++vertical) {
+                const auto y = static_cast<Pixel>(upward ? n - 1 - vertical : vertical);
+
+                for (Pixel j = 0; j < 2; ++j) {
+                    const auto x = static_cast<Pixel>(right - j);
+                    if ((functions[x] >> y) & 1 or bit >= total_bits) { continue; }
+
+                    if ((bit & 7) == 0) { byte = interleaved(bit >> 3); }
+                    if ((byte >> (7 - (bit & 7))) & 1) { modules[x] |= u64{1} << y; }
+                    bit += 1;
+                }
+            }
+        }
+    }
+
+    /// @brief Инвертировать модули данных по маске (повторный вызов отменяет)
+    void applyMask(u8 mask) noexcept {
+        const Pixel n = size();
+        const u64 rows = (u64{1} << n) - 1;
+
+        // Период всех масок: 6 столбцов
+        u64 pattern[6];
+        for (Pixel x = 0; x < 6; ++x) { pattern[x] = maskColumn(mask, x); }
+
+        for (Pixel x = 0; x < n; ++x) { modules[x] ^= pattern[x % 6] & rows & ~functions[x]; }
+    }
+
+    /// @brief Столбец маски: период всех масок по Y - 12 строк
+    [[nodiscard]] static u64 maskColumn(u8 mask, Pixel x) noexcept {
+        u64 period = 0;
+        for (Pixel y = 0; y < 12; ++y) {
+            bool on;
+            switch (mask) {
+                case 0: on = (x + y) % 2 == 0; break;
+                case 1: on = y % 2 == 0; break;
+                case 2: on = x % 3 == 0; break;
+                case 3: on = (x + y) % 3 == 0; break;
+                case 4: on = (x / 3 + y / 2) % 2 == 0; break;
+                case 5: on = x * y % 2 + x * y % 3 == 0; break;
+                case 6: on = (x * y % 2 + x * y % 3) % 2 == 0; break;
+                default: on = ((x + y) % 2 + x * y % 3) % 2 == 0; break;
+            }
+            if (on) { period |= u64{1} << y; }
+        }
+
+        return period | period << 12 | period << 24 | period << 36 | period << 48 | period << 60;
+    }
+
+    [[nodiscard]] u8 bestMask() noexcept {
+        u8 best = 0;
+        u32 best_penalty = ~u32{0};
+
+        for (u8 mask = 0; mask < 8; ++mask) {
+            applyMask(mask);
+            drawFormatBits(mask);
+
+            const u32 current = penalty();
+            if (current < best_penalty) {
+                best_penalty = current;
+                best = mask;
+            }
+
+            applyMask(mask);
+        }
+
+        return best;
+    }
+
+    /// @brief Позиции узоров 1:1:3:1:1 с 4 светлыми модулями с одной из сторон
+    /// @param line <code>u64(Pixel k)</code> - k-е модули последовательностей всех позиций сразу
+    template<typename Line> [[nodiscard]] static u64 finderLike(Line &&line) noexcept {
+        u64 forward = ~u64{0};
+        u64 backward = ~u64{0};
+
+        for (Pixel k = 0; k < 11; ++k) {
+            const u64 bits = line(k);
+            forward &= ((0x05D >> k) & 1) ? bits : ~bits;
+            backward &= ((0x5D0 >> k) & 1) ? bits : ~bits;
+        }
+
+        return forward | backward;
+    }
+
+    /// @brief Штраф маски
+    /// @details Строки обрабатываются параллельно по битам слов столбцов, столбцы - сдвигами слова.
+    /// Серия длины L содержит L - 4 окон из 5 одинаковых модулей и штрафуется на L - 2
+    [[nodiscard]] u32 penalty() const noexcept {
+        const Pixel n = size();
+        const u64 all = (u64{1} << n) - 1;
+        const u64 starts = (u64{1} << (n - 10)) - 1;
+        u32 result = 0;
+        usize dark = 0;
+        u64 previous_windows = 0;
+
+        const auto same = [this, all](Pixel x) { return ~(modules[x] ^ modules[x + 1]) & all; };
+
+        for (Pixel x = 0; x < n; ++x) {
+            const u64 column = modules[x];
+            dark += countOnes(column);
+
+            // Столбец
+            const u64 vertical = ~(column ^ (column >> 1)) & (all >> 1);
+            const u64 vertical_windows = vertical & (vertical >> 1) & (vertical >> 2) & (vertical >> 3);
+            result += countOnes(vertical_windows) + 2u * countOnes(vertical_windows & ~(vertical_windows << 1));
+            result += 40u * countOnes(finderLike([column](Pixel k) { return column >> k; }) & starts);
+
+            // Строки: окна из 5 модулей, начинающиеся в столбце x
+            if (x + 4 < n) {
+                const u64 windows = same(x) & same(static_cast<Pixel>(x + 1)) & same(static_cast<Pixel>(x + 2)) & same(static_cast<Pixel>(x + 3));
+                result += countOnes(windows) + 2u * countOnes(windows & ~previous_windows);
+                previous_windows = windows;
+            }
+
+            if (x + 11 <= n) {
+                result += 40u * countOnes(finderLike([this, x](Pixel k) { return modules[x + k]; }) & all);
+            }
+
+            // Блоки 2x2 одного цвета
+            if (x + 1 < n) {
+                const u64 next = modules[x + 1];
+                result += 3u * countOnes(same(x) & vertical & ~(next ^ (next >> 1)));
+            }
+        }
+
+        // Отклонение доли тёмных модулей от 50% шагами по 5%
+        const usize total = static_cast<usize>(n) * n;
+        const usize deviation = dark * 20 > total * 10 ? dark * 20 - total * 10 : total * 10 - dark * 20;
+        result += static_cast<u32>(((deviation + total - 1) / total - 1) * 10);
+
+        return result;
+    }
+
+    /// @brief 16 строк столбца пикселей начиная со строки row (бит 0 - строка row)
+    [[nodiscard]] static u16 expandColumn(u64 dark, Pixel row, u8 scale, u8 quiet) noexcept {
+        u32 bits = 0;
+        const auto end = static_cast<Pixel>(row + 16);
+
+        // Строки одного модуля записываются одной маской
+        for (Pixel pixel = row; pixel < end;) {
+            const auto module_row = static_cast<Pixel>(pixel / scale);
+            const auto next = static_cast<Pixel>(std::min<int>(end, (module_row + 1) * scale));
+            const auto module_y = static_cast<Pixel>(module_row - quiet);
+
+            if (module_y >= 0 and module_y < max_size and ((dark >> module_y) & 1)) {
+                bits |= ((1u << (next - row)) - 1) & ~((1u << (pixel - row)) - 1);
+            }
+            pixel = next;
+        }
+
+        return static_cast<u16>(bits);
+    }
+};
+
+}// namespace kf::gfx
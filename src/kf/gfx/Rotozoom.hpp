@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+
+#include <kf/units.hpp>
+
+#include "kf/gfx/BitMap.hpp"
+#include "kf/gfx/Collision.hpp"
+#include "kf/gfx/FrameView.hpp"
+#include "kf/gfx/Trig.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Вывод битмапа с поворотом и масштабом
+/// @details Обратное отображение в фиксированной точке Q16: для каждого пикселя области вывода
+/// вычисляется точка битмапа. Область вывода (образ углов битмапа) отсекается по границам заранее.
+/// Столбец проходится сверху вниз прибавлением шага к координатам битмапа, биты 8 строк
+/// собираются в байт страницы и записываются один раз
+namespace rotozoom {
+
+/// @brief Масштаб 1:1 (Q8)
+static constexpr u16 zoom_one = 256;
+
+/// @brief Дробных бит координат битмапа
+static constexpr u8 fraction_bits = 16;
+
+/// @brief Сузить [begin, end) до шагов t, при которых 0 <= start + t * step < limit
+inline void clipRows(i32 start, i32 step, i32 limit, i32 &begin, i32 &end) noexcept {
+    const auto floor_div = [](i32 a, i32 b) { return a / b - ((a % b != 0) and ((a < 0) != (b < 0))); };
+
+    if (step == 0) {
+        if (start < 0 or start >= limit) { end = begin; }
+        return;
+    }
+
+    if (step > 0) {
+        begin = std::max(begin, -floor_div(start, step));
+        end = std::min(end, -floor_div(start - limit, step));
+    } else {
+        begin = std::max(begin, floor_div(start - limit, -step) + 1);
+        end = std::min(end, floor_div(start, -step) + 1);
+    }
+}
+
+/// @brief Прямоугольник вывода, не отсечённый по области
+/// @param center_x, center_y Точка области, в которую попадает центр битмапа
+/// @param zoom Масштаб, Q8 (256 - 1:1)
+[[nodiscard]] inline collision::Box bounds(
+    const BitMapView &bitmap,
+    Pixel center_x,
+    Pixel center_y,
+    trig::Angle angle,
+    u16 zoom = zoom_one) noexcept {
+    const trig::Rotation rotation{angle};
+    const auto half_width = static_cast<Pixel>(bitmap.width / 2);
+    const auto half_height = static_cast<Pixel>(bitmap.height / 2);
+
+    i32 left = 0, top = 0, right = 0, bottom = 0;
+    for (u8 corner = 0; corner < 4; ++corner) {
+        const i32 sx = (corner & 1) ? bitmap.width - half_width : -half_width;
+        const i32 sy = (corner & 2) ? bitmap.height - half_height : -half_height;
+        const i32 x = (rotation.x(sx, sy) * zoom) >> 8;
+        const i32 y = (rotation.y(sx, sy) * zoom) >> 8;
+
+        left = corner == 0 ? x : std::min(left, x);
+        top = corner == 0 ? y : std::min(top, y);
+        right = corner == 0 ? x : std::max(right, x);
+        bottom = corner == 0 ? y : std::max(bottom, y);
+    }
+
+    // Запас на пиксель от округления
+    return collision::Box{
+        static_cast<Pixel>(center_x + left - 1),
+        static_cast<Pixel>(center_y + top - 1),
+        static_cast<Pixel>(center_x + right + 2),
+        static_cast<Pixel>(center_y + bottom + 2),
+    };
+}
+
+/// @brief Вывести битмап с поворотом на angle и масштабом zoom
+/// @param center_x, center_y Точка области, в которую попадает центр битмапа
+/// @param zoom Масштаб, Q8 (256 - 1:1), > 0
+/// @param on Значение пикселей изображения
+/// @param opaque false - записываются только включённые пиксели битмапа (как drawBitmap),
+/// true - весь образ битмапа, выключенные пиксели - значением not on
+/// @details При angle = 0 и zoom = 256 совпадает с drawBitmap в (center_x - width / 2, center_y - height / 2)
+/// @details Битмап меньше 32768 / 2 пикселей по каждой стороне
+/// @returns Прямоугольник вывода, отсечённый по области
+inline collision::Box draw(
+    const FrameView &target,
+    const BitMapView &bitmap,
+    Pixel center_x,
+    Pixel center_y,
+    trig::Angle angle,
+    u16 zoom = zoom_one,
+    bool on = true,
+    bool opaque = false) noexcept {
+    collision::Box box = bounds(bitmap, center_x, center_y, angle, zoom);
+    box.left = std::max(box.left, static_cast<Pixel>(0));
+    box.top = std::max(box.top, static_cast<Pixel>(0));
+    box.right = std::min(box.right, target.width);
+    box.bottom = std::min(box.bottom, target.height);
+    if (not target.isValid() or nullptr == bitmap.buffer or zoom == 0 or box.empty()) { return box; }
+
+    // Шаги координат битмапа (Q16) по X и по Y области: R(-angle) / zoom
+    const i32 cosine = trig::cos(angle) * (1 << 10) / zoom;
+    const i32 sine = trig::sin(angle) * (1 << 10) / zoom;
+    const i32 u_dx = cosine, v_dx = -sine;
+    const i32 u_dy = sine, v_dy = cosine;
+
+    // Координаты битмапа для пикселя (box.left, box.top)
+    const i32 dx = box.left - center_x;
+    const i32 dy = box.top - center_y;
+    i32 u_column = bitmap.width / 2 * (1 << fraction_bits) + dx * u_dx + dy * u_dy;
+    i32 v_column = bitmap.height / 2 * (1 << fraction_bits) + dx * v_dx + dy * v_dy;
+
+    const i32 u_limit = bitmap.width * (1 << fraction_bits);
+    const i32 v_limit = bitmap.height * (1 << fraction_bits);
+    const i32 rows = box.bottom - box.top;
+    const Pixel abs_top = target.toAbsoluteY(box.top);
+
+    for (Pixel x = box.left; x < box.right; ++x, u_column += u_dx, v_column += v_dx) {
+        // Строки столбца внутри битмапа - пересечение диапазонов по u и по v, без проверок в цикле
+        i32 begin = 0;
+        i32 end = rows;
+        clipRows(u_column, u_dy, u_limit, begin, end);
+        clipRows(v_column, v_dy, v_limit, begin, end);
+        if (begin >= end) { continue; }
+
+        const Pixel abs_x = target.toAbsoluteX(x);
+        i32 u = u_column + begin * u_dy;
+        i32 v = v_column + begin * v_dy;
+        auto row = static_cast<Pixel>(abs_top + begin);
+        u8 bits = 0;
+        u8 cover = 0;
+
+        for (i32 t = begin; t < end; ++t, ++row, u += u_dy, v += v_dy) {
+            const auto bit = static_cast<u8>(row & 0x07);
+            const auto su = static_cast<Pixel>(u >> fraction_bits);
+            const auto sv = static_cast<Pixel>(v >> fraction_bits);
+
+            bits |= static_cast<u8>(((bitmap.buffer[(sv >> 3) * bitmap.width + su] >> (sv & 0x07)) & 1) << bit);
+            cover |= static_cast<u8>(1 << bit);
+
+            if (bit != 7 and t != end - 1) { continue; }
+
+            // Байт страницы собран
+            const auto page = static_cast<Pixel>(row >> 3);
+            if (opaque) {
+                target.writeMaskedData(abs_x, page, on ? bits : static_cast<u8>(~bits), cover);
+            } else if (bits != 0) {
+                target.writeData(abs_x, page, bits, on);
+            }
+
+            bits = 0;
+            cover = 0;
+        }
+    }
+
+    return box;
+}
+
+}// namespace rotozoom
+}// namespace kf::gfx
@@ -0,0 +1,448 @@
+#pragma once
+
+#include <algorithm>
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Крупное сегментное табло (семь или четырнадцать сегментов)
+/// @details Сегменты - прямоугольники (диагонали - лесенкой из прямоугольников), страницы
+/// и маски строк которых вычисляются один раз для положения табло.
+/// Сегмент записывается побайтово по страницам, без попиксельного рисования
+/// @details Перерисовываются только сегменты, сменившие состояние. После гашения сегмента
+/// перерисовываются горящие сегменты, пересекающиеся с ним (общие углы)
+/// @tparam Digits Количество знакомест
+template<u8 Digits> struct SegmentDisplay final {
+
+    /// @brief Тип знакоместа
+    enum class Kind : u8 {
+
+        /// @brief Семь сегментов: a-g (биты 0-6)
+        Seven,
+
+        /// @brief Четырнадцать сегментов: a-f, g1, g2, диагонали и центральные вертикали (биты 0-13)
+        Fourteen,
+    };
+
+    /// @brief Ошибки
+    enum class Error : u8 {
+
+        /// @brief Высота мала для толщины штриха
+        BadGeometry,
+    };
+
+    /// @brief Десятичная точка (в промежутке справа от знака)
+    static constexpr u16 segment_dp = 1 << 15;
+
+    /// @brief Количество ступеней диагонального сегмента
+    static constexpr u8 diagonal_steps = 8;
+
+private:
+    /// @brief Максимум прямоугольников знакоместа
+    static constexpr u8 max_rects = 10 + 4 * diagonal_steps + 1;
+
+    /// @brief Прямоугольник в координатах знакоместа (правая и нижняя границы не включаются)
+    struct Rect final {
+        Pixel x0, y0, x1, y1;
+    };
+
+    /// @brief Страницы прямоугольника для текущего положения табло
+    struct Pages final {
+
+        /// @brief Первая страница (абсолютная)
+        Pixel first;
+
+        /// @brief Последняя страница (абсолютная)
+        Pixel last;
+
+        /// @brief Маска строк первой страницы (0 - прямоугольник отсечён)
+        u8 first_mask;
+
+        /// @brief Маска строк последней страницы
+        u8 last_mask;
+    };
+
+    /// @brief Шрифт семи сегментов (ASCII 0x20-0x5F)
+    static constexpr u8 font_seven[64] = {
+        0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x00, 0x02,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00,
+        0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
+        0x7F, 0x6F, 0x00, 0x00, 0x00, 0x48, 0x00, 0x53,
+        0x00, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71, 0x3D,
+        0x76, 0x30, 0x1E, 0x00, 0x38, 0x00, 0x54, 0x3F,
+        0x73, 0x67, 0x50, 0x6D, 0x78, 0x3E, 0x00, 0x00,
+        0x00, 0x6E, 0x5B, 0x39, 0x00, 0x0F, 0x00, 0x08,
+    };
+
+    /// @brief Шрифт четырнадцати сегментов (ASCII 0x20-0x5F)
+    /// @details Биты: a b c d e f g1 g2, h (диагональ слева сверху), i (вертикаль сверху),
+    /// j (диагональ справа сверху), k (диагональ слева снизу), l (вертикаль снизу), m (диагональ справа снизу)
+    static constexpr u16 font_fourteen[64] = {
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0200,
+        0x2400, 0x0900, 0x3FC0, 0x12C0, 0x0800, 0x00C0, 0x0000, 0x0C00,
+        0x0C3F, 0x0406, 0x00DB, 0x008F, 0x00E6, 0x00ED, 0x00FD, 0x0007,
+        0x00FF, 0x00EF, 0x0000, 0x0000, 0x2400, 0x00C8, 0x0900, 0x1083,
+        0x0000, 0x00F7, 0x128F, 0x0039, 0x120F, 0x0079, 0x0071, 0x00BD,
+        0x00F6, 0x1209, 0x001E, 0x2470, 0x0038, 0x0536, 0x2136, 0x003F,
+        0x00F3, 0x203F, 0x20F3, 0x00ED, 0x1201, 0x003E, 0x0C30, 0x2836,
+        0x2D00, 0x1500, 0x0C09, 0x0039, 0x2100, 0x000F, 0x0000, 0x0008,
+    };
+
+    /// @brief Прямоугольники сегментов подряд
+    Rect rects[max_rects]{};
+
+    /// @brief Страницы прямоугольников
+    Pages pages[max_rects]{};
+
+    /// @brief Начало прямоугольников сегмента (сегмент s: rect_begin[s]..rect_begin[s + 1])
+    u8 rect_begin[17]{};
+
+    /// @brief Сегменты, пересекающиеся с сегментом
+    u16 overlap[16]{};
+
+    /// @brief Знакоместо целиком вместе с промежутком
+    Rect cell{};
+
+    /// @brief Страницы знакоместа
+    Pages cell_pages{};
+
+    /// @brief Сегменты знакомест для отображения
+    u16 wanted[Digits]{};
+
+    /// @brief Сегменты знакомест на экране
+    u16 shown[Digits]{};
+
+    /// @brief Тип знакоместа
+    Kind kind;
+
+    /// @brief Значение пикселей горящего сегмента
+    bool on;
+
+    /// @brief Шаг знакомест
+    Pixel pitch;
+
+    /// @brief Положение, для которого вычислены страницы
+    Pixel last_x{0}, last_y{0}, last_offset_x{0}, last_offset_y{0}, last_width{0}, last_height{0};
+
+    /// @brief Перерисовать всё
+    bool redraw_all{true};
+
+public:
+    /// @brief Создать табло
+    /// @param height Высота знака в пикселях
+    /// @param stroke Толщина штриха
+    /// @param kind Тип знакоместа
+    /// @param on Значение пикселей горящего сегмента
+    /// @details Ширина знака (height + stroke) / 2 для семи сегментов и (height + stroke) * 2 / 3
+    /// для четырнадцати, промежуток stroke + 2 (в нём десятичная точка).
+    /// Требуется height >= 3 * stroke + 2, для четырнадцати сегментов ещё ширина >= 5 * stroke
+    [[nodiscard]] static Result<SegmentDisplay, Error> create(
+        Pixel height, Pixel stroke, Kind kind = Kind::Seven, bool on = true) noexcept {
+        const auto width = static_cast<Pixel>(kind == Kind::Seven ? (height + stroke) / 2 : (height + stroke) * 2 / 3);
+
+        if (stroke < 1 or height < 3 * stroke + 2 or (kind == Kind::Fourteen and width < 5 * stroke)) {
+            return Error::BadGeometry;
+        }
+
+        return SegmentDisplay{height, stroke, width, kind, on};
+    }
+
+    /// @brief Ширина табло в пикселях (вместе с точкой последнего знака)
+    [[nodiscard]] inline Pixel pixelWidth() const noexcept { return static_cast<Pixel>(Digits * pitch); }
+
+    /// @brief Высота табло в пикселях
+    [[nodiscard]] inline Pixel pixelHeight() const noexcept { return cell.y1; }
+
+    /// @brief Сегменты знакоместа
+    [[nodiscard]] inline u16 segments(u8 position) const noexcept {
+        return position < Digits ? wanted[position] : 0;
+    }
+
+    /// @brief Установить сегменты знакоместа
+    inline void setSegments(u8 position, u16 segments) noexcept {
+        if (position < Digits) { wanted[position] = segments; }
+    }
+
+    /// @brief Сегменты символа (строчные - как прописные, неизвестные - пусто)
+    [[nodiscard]] u16 glyph(char c) const noexcept {
+        auto code = static_cast<u8>(c);
+        if (code >= 'a' and code <= 'z') { code = static_cast<u8>(code - 'a' + 'A'); }
+        if (code < 0x20 or code >= 0x60) { return 0; }
+
+        return kind == Kind::Seven ? font_seven[code - 0x20] : font_fourteen[code - 0x20];
+    }
+
+    /// @brief Вывести текст с первого знакоместа
+    /// @details '.' зажигает точку предыдущего знака, оставшиеся знакоместа гаснут
+    /// @returns false, если текст не поместился
+    bool print(const char *text) noexcept {
+        u8 position = 0;
+
+        for (; *text != '\0'; ++text) {
+            if (*text == '.' and position > 0 and not(wanted[position - 1] & segment_dp)) {
+                wanted[position - 1] |= segment_dp;
+                continue;
+            }
+
+            if (position == Digits) { return false; }
+            wanted[position] = *text == '.' ? segment_dp : glyph(*text);
+            position += 1;
+        }
+
+        for (; position < Digits; ++position) { wanted[position] = 0; }
+        return true;
+    }
+
+    /// @brief Вывести число с выравниванием вправо
+    /// @param decimals Знаков после точки
+    /// @details При переполнении все знакоместа - '-'
+    /// @returns false при переполнении
+    bool print(i32 value, u8 decimals = 0) noexcept {
+        const bool negative = value < 0;
+        auto rest = negative ? static_cast<u32>(0) - static_cast<u32>(value) : static_cast<u32>(value);
+        const u16 minus = glyph('-');
+
+        for (u8 i = 0; i < Digits; ++i) { wanted[i] = 0; }
+
+        auto position = static_cast<i16>(Digits - 1);
+        for (u8 i = 0; rest != 0 or i <= decimals; ++i, --position) {
+            if (position < 0) { return overflow(minus); }
+
+            wanted[position] = glyph(static_cast<char>('0' + rest % 10));
+            if (i == decimals and decimals != 0) { wanted[position] |= segment_dp; }
+            rest /= 10;
+        }
+
+        if (negative) {
+            if (position < 0) { return overflow(minus); }
+            wanted[position] = minus;
+        }
+
+        return true;
+    }
+
+    /// @brief Перерисовать всё при следующем render()
+    void invalidate() noexcept { redraw_all = true; }
+
+    /// @brief Отрисовать сегменты, сменившие состояние
+    /// @param x, y Левый верхний угол табло
+    /// @details Смена положения или области перерисовывает всё (знакоместа очищаются целиком)
+    /// @returns Количество записанных сегментов
+    usize render(const FrameView &target, Pixel x, Pixel y) noexcept {
+        if (not target.isValid()) { return 0; }
+
+        if (x != last_x or y != last_y or target.offset_x != last_offset_x or target.offset_y != last_offset_y or
+            target.width != last_width or target.height != last_height) {
+            place(target, x, y);
+        }
+
+        usize written = 0;
+
+        for (u8 position = 0; position < Digits; ++position) {
+            const auto left = static_cast<Pixel>(x + position * pitch);
+            const u16 next = wanted[position];
+            u16 clear;
+            u16 draw;
+
+            if (redraw_all) {
+                drawRect(target, left, cell, cell_pages, not on);
+                clear = 0;
+                draw = next;
+            } else {
+                clear = static_cast<u16>(shown[position] & ~next);
+                draw = static_cast<u16>(next & ~shown[position]);
+            }
+
+            // Погашенный сегмент мог стереть общие пиксели горящих соседей
+            u16 repair = 0;
+            for (u8 s = 0; clear != 0; ++s, clear >>= 1) {
+                if (clear & 1) {
+                    drawSegment(target, left, s, not on);
+                    repair |= overlap[s];
+                    written += 1;
+                }
+            }
+
+            draw |= static_cast<u16>(next & repair);
+            for (u8 s = 0; draw != 0; ++s, draw >>= 1) {
+                if (draw & 1) {
+                    drawSegment(target, left, s, on);
+                    written += 1;
+                }
+            }
+
+            shown[position] = next;
+        }
+
+        redraw_all = false;
+        return written;
+    }
+
+private:
+    SegmentDisplay(Pixel height, Pixel stroke, Pixel width, Kind kind, bool on) noexcept :
+        kind{kind}, on{on}, pitch{static_cast<Pixel>(width + stroke + 2)} {
+        const Pixel w = width;
+        const Pixel h = height;
+        const Pixel s = stroke;
+        const auto mid = static_cast<Pixel>((h - s) / 2);
+        u8 count = 0;
+
+        const auto add = [this, &count](Pixel x0, Pixel y0, Pixel x1, Pixel y1) {
+            rects[count] = {x0, y0, x1, y1};
+            count += 1;
+        };
+
+        const auto next = [this, &count](u8 segment) {
+            for (u8 s = segment + 1; s <= 16; ++s) { rect_begin[s] = count; }
+        };
+
+        // a, b, c, d, e, f
+        add(0, 0, w, s), next(0);
+        add(static_cast<Pixel>(w - s), 0, w, static_cast<Pixel>(mid + s)), next(1);
+        add(static_cast<Pixel>(w - s), mid, w, h), next(2);
+        add(0, static_cast<Pixel>(h - s), w, h), next(3);
+        add(0, mid, s, h), next(4);
+        add(0, 0, s, static_cast<Pixel>(mid + s)), next(5);
+
+        if (kind == Kind::Seven) {
+            add(0, mid, w, static_cast<Pixel>(mid + s)), next(6);
+        } else {
+            const auto cx = static_cast<Pixel>((w - s) / 2);
+
+            // g1, g2
+            add(0, mid, static_cast<Pixel>(cx + s), static_cast<Pixel>(mid + s)), next(6);
+            add(cx, mid, w, static_cast<Pixel>(mid + s)), next(7);
+
+            // Диагональ h лесенкой в прямоугольнике [s, cx) x [s, mid), остальные - её отражения
+            const auto dx = static_cast<Pixel>(cx - s);
+            const auto dy = static_cast<Pixel>(mid - s);
+            const auto band = std::max(static_cast<Pixel>(1), std::min(s, static_cast<Pixel>(dx / 2)));
+            const auto steps = static_cast<Pixel>(std::min(static_cast<Pixel>(diagonal_steps), dy));
+            const auto step = [&](Pixel k, bool mirror_x, bool mirror_y) {
+                const auto x0 = static_cast<Pixel>(s + (dx - band) * k / steps);
+                const auto x1 = static_cast<Pixel>(s + (dx - band) * (k + 1) / steps + band);
+                const auto y0 = static_cast<Pixel>(s + dy * k / steps);
+                const auto y1 = static_cast<Pixel>(s + dy * (k + 1) / steps);
+                add(mirror_x ? static_cast<Pixel>(w - x1) : x0,
+                    mirror_y ? static_cast<Pixel>(h - y1) : y0,
+                    mirror_x ? static_cast<Pixel>(w - x0) : x1,
+                    mirror_y ? static_cast<Pixel>(h - y0) : y1);
+            };
+
+            // h, i, j
+            for (Pixel k = 0; k < steps; ++k) { step(k, false, false); }
+            next(8);
+            add(cx, 0, static_cast<Pixel>(cx + s), static_cast<Pixel>(mid + s)), next(9);
+            for (Pixel k = 0; k < steps; ++k) { step(k, true, false); }
+            next(10);
+
+            // k, l, m
+            for (Pixel k = 0; k < steps; ++k) { step(k, false, true); }
+            next(11);
+            add(cx, mid, static_cast<Pixel>(cx + s), h), next(12);
+            for (Pixel k = 0; k < steps; ++k) { step(k, true, true); }
+            next(13);
+        }
+
+        // Точка по центру промежутка
+        add(static_cast<Pixel>(w + 1), static_cast<Pixel>(h - s), static_cast<Pixel>(w + 1 + s), h), next(15);
+
+        cell = {0, 0, pitch, h};
+
+        for (u8 a = 0; a < 16; ++a) {
+            for (u8 b = 0; b < 16; ++b) {
+                if (a != b and intersects(a, b)) { overlap[a] |= static_cast<u16>(1 << b); }
+            }
+        }
+    }
+
+    /// @brief Пересекаются ли прямоугольники сегментов
+    [[nodiscard]] bool intersects(u8 a, u8 b) const noexcept {
+        for (u8 i = rect_begin[a]; i < rect_begin[a + 1]; ++i) {
+            for (u8 j = rect_begin[b]; j < rect_begin[b + 1]; ++j) {
+                if (rects[i].x0 < rects[j].x1 and rects[j].x0 < rects[i].x1 and
+                    rects[i].y0 < rects[j].y1 and rects[j].y0 < rects[i].y1) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /// @brief Вычислить страницы прямоугольников для положения табло
+    void place(const FrameView &target, Pixel x, Pixel y) noexcept {
+        for (u8 i = 0; i < rect_begin[16]; ++i) { pages[i] = pagesOf(target, y, rects[i]); }
+        cell_pages = pagesOf(target, y, cell);
+
+        last_x = x;
+        last_y = y;
+        last_offset_x = target.offset_x;
+        last_offset_y = target.offset_y;
+        last_width = target.width;
+        last_height = target.height;
+        redraw_all = true;
+    }
+
+    /// @brief Страницы и маски строк прямоугольника с отсечением по высоте области
+    [[nodiscard]] static Pages pagesOf(const FrameView &target, Pixel y, const Rect &rect) noexcept {
+        const auto top = static_cast<Pixel>(std::max(y + rect.y0, 0));
+        const auto bottom = static_cast<Pixel>(std::min(y + rect.y1, static_cast<int>(target.height)) - 1);
+        if (top > bottom) { return {0, -1, 0, 0}; }
+
+        const Pixel abs_top = target.toAbsoluteY(top);
+        const Pixel abs_bottom = target.toAbsoluteY(bottom);
+        Pages result{
+            static_cast<Pixel>(abs_top >> 3),
+            static_cast<Pixel>(abs_bottom >> 3),
+            FrameView::createPageMask(static_cast<u8>(abs_top & 0x07), 7),
+            FrameView::createPageMask(0, static_cast<u8>(abs_bottom & 0x07)),
+        };
+
+        if (result.first == result.last) {
+            result.first_mask &= result.last_mask;
+            result.last_mask = result.first_mask;
+        }
+
+        return result;
+    }
+
+    /// @brief Записать прямоугольники сегмента
+    inline void drawSegment(const FrameView &target, Pixel left, u8 segment, bool value) const noexcept {
+        for (u8 i = rect_begin[segment]; i < rect_begin[segment + 1]; ++i) {
+            drawRect(target, left, rects[i], pages[i], value);
+        }
+    }
+
+    /// @brief Записать прямоугольник побайтово по страницам
+    static void drawRect(const FrameView &target, Pixel left, const Rect &rect, const Pages &rect_pages, bool value) noexcept {
+        if (rect_pages.first_mask == 0) { return; }
+
+        const auto x0 = static_cast<Pixel>(std::max(left + rect.x0, 0));
+        const auto x1 = static_cast<Pixel>(std::min(left + rect.x1, static_cast<int>(target.width)));
+        if (x0 >= x1) { return; }
+
+        const Pixel abs_x0 = target.toAbsoluteX(x0);
+        const Pixel abs_x1 = target.toAbsoluteX(x1);
+
+        for (Pixel page = rect_pages.first; page <= rect_pages.last; ++page) {
+            const u8 mask = page == rect_pages.first ? rect_pages.first_mask :
+                            page == rect_pages.last  ? rect_pages.last_mask :
+                                                       0xFF;
+
+            for (Pixel abs_x = abs_x0; abs_x < abs_x1; ++abs_x) { target.writeData(abs_x, page, mask, value); }
+        }
+    }
+
+    /// @brief Заполнить знакоместа символом переполнения
+    bool overflow(u16 segments) noexcept {
+        for (u8 i = 0; i < Digits; ++i) { wanted[i] = segments; }
+        return false;
+    }
+};
+
+}// namespace kf::gfx
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/FrameDelta.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Формат выгрузки SnapshotRecorder
+/// @details "KFSN", версия (u8), ширина (u16), высота (u16), количество кадров (u16),
+/// последний кадр целиком, затем записи от старой к новой: длина (u16) и дельта (frame_delta)
+/// @details Числа little-endian
+namespace snapshot {
+
+/// @brief Сигнатура выгрузки
+static constexpr u8 magic[4] = {'K', 'F', 'S', 'N'};
+
+/// @brief Версия формата
+static constexpr u8 version = 1;
+
+/// @brief Размер заголовка в байтах
+static constexpr usize header_size = 11;
+
+/// @brief Размер заголовка записи (длина дельты)
+static constexpr usize entry_header_size = 2;
+
+}// namespace snapshot
+
+/// @brief Кольцевой журнал последних кадров ("чёрный ящик")
+/// @details Хранит последний кадр и дельты (frame_delta) каждого кадра относительно предыдущего.
+/// Так как XOR симметричен, более старые кадры восстанавливаются от последнего к первому,
+/// поэтому вытеснение старейшей записи не требует пересчёта.
+/// @details Запись кадра: два прохода XOR по буферу и копирование кадра
+/// @tparam W Ширина дисплея
+/// @tparam H Высота дисплея
+/// @tparam Capacity Объём кольцевого буфера дельт в байтах
+template<Pixel W, Pixel H, usize Capacity> struct SnapshotRecorder final {
+
+    /// @brief Размер кадра в байтах
+    static constexpr usize frame_size = W * ((H + 7) / 8);
+
+    static_assert(Capacity >= snapshot::entry_header_size + 1, "Capacity too small");
+
+private:
+    /// @brief Последний записанный кадр
+    u8 last[frame_size]{};
+
+    /// @brief Кольцевой буфер записей
+    u8 ring[Capacity]{};
+
+    /// @brief Начало старейшей записи
+    usize head{0};
+
+    /// @brief Занятый объём
+    usize used{0};
+
+    /// @brief Количество записей
+    u16 count{0};
+
+public:
+    /// @brief Количество сохранённых кадров
+    [[nodiscard]] inline u16 frames() const noexcept { return count; }
+
+    /// @brief Занятый объём кольцевого буфера
+    [[nodiscard]] inline usize size() const noexcept { return used; }
+
+    /// @brief Последний записанный кадр
+    [[nodiscard]] inline const u8 *latest() const noexcept { return last; }
+
+    /// @brief Очистить журнал
+    void clear() noexcept {
+        std::memset(last, 0, frame_size);
+        head = 0;
+        used = 0;
+        count = 0;
+    }
+
+    /// @brief Записать кадр
+    /// @param frame Буфер дисплея (frame_size байт)
+    /// @returns false, если дельта кадра больше всего буфера и кадр пропущен
+    bool record(const u8 *frame) noexcept {
+        const usize delta_size = frame_delta::encodedSize(frame, last, frame_size);
+        const usize entry_size = snapshot::entry_header_size + delta_size;
+
+        if (entry_size > Capacity or delta_size > 0xFFFF) { return false; }
+
+        while (Capacity - used < entry_size or count == 0xFFFF) { evict(); }
+
+        usize position = (head + used) % Capacity;
+        const auto put = [this, &position](u8 byte) {
+            ring[position] = byte;
+            position = (position + 1 == Capacity) ? 0 : position + 1;
+        };
+
+        put(static_cast<u8>(delta_size));
+        put(static_cast<u8>(delta_size >> 8));
+        frame_delta::encode(frame, last, frame_size, put);
+
+        used += entry_size;
+        count += 1;
+        std::memcpy(last, frame, frame_size);
+        return true;
+    }
+
+    /// @brief Выгрузить журнал (см. snapshot)
+    /// @param write Приёмник данных: <code>void(const u8 *data, usize size)</code>
+    template<typename Write> void dump(Write &&write) const noexcept {
+        const u8 header[snapshot::header_size] = {
+            snapshot::magic[0],
+            snapshot::magic[1],
+            snapshot::magic[2],
+            snapshot::magic[3],
+            snapshot::version,
+            static_cast<u8>(W),
+            static_cast<u8>(W >> 8),
+            static_cast<u8>(H),
+            static_cast<u8>(H >> 8),
+            static_cast<u8>(count),
+            static_cast<u8>(count >> 8),
+        };
+
+        write(header, snapshot::header_size);
+        write(last, frame_size);
+
+        // Записи от старой к новой, с учётом перехода через конец кольца
+        const usize first_part = std::min(used, Capacity - head);
+        write(ring + head, first_part);
+        if (first_part < used) { write(ring, used - first_part); }
+    }
+
+private:
+    /// @brief Вытеснить старейшую запись
+    void evict() noexcept {
+        const usize delta_size = ring[head] | (ring[(head + 1) % Capacity] << 8);
+        const usize entry_size = snapshot::entry_header_size + delta_size;
+
+        head = (head + entry_size) % Capacity;
+        used -= entry_size;
+        count -= 1;
+    }
+};
+
+/// @brief Чтение выгрузки SnapshotRecorder (на хосте)
+struct SnapshotReader final {
+
+    /// @brief Ошибки чтения
+    enum class Error : u8 {
+
+        /// @brief Неверная сигнатура или размер заголовка
+        BadHeader,
+
+        /// @brief Неподдерживаемая версия формата
+        UnsupportedVersion,
+
+        /// @brief Выгрузка обрывается
+        Truncated,
+
+        /// @brief Повреждённая дельта
+        Corrupted,
+    };
+
+private:
+    /// @brief Данные выгрузки
+    const u8 *data;
+
+    /// @brief Размер выгрузки
+    usize data_size;
+
+public:
+    /// @brief Ширина кадра
+    Pixel width;
+
+    /// @brief Высота кадра
+    Pixel height;
+
+    /// @brief Количество кадров
+    u16 frames;
+
+    /// @brief Проверить заголовок выгрузки
+    [[nodiscard]] static Result<SnapshotReader, Error> create(const u8 *data, usize data_size) noexcept {
+        if (nullptr == data or data_size < snapshot::header_size) { return Error::BadHeader; }
+
+        for (usize i = 0; i < sizeof(snapshot::magic); ++i) {
+            if (data[i] != snapshot::magic[i]) { return Error::BadHeader; }
+        }
+
+        if (data[4] != snapshot::version) { return Error::UnsupportedVersion; }
+
+        const SnapshotReader reader{
+            data,
+            data_size,
+            static_cast<Pixel>(data[5] | (data[6] << 8)),
+            static_cast<Pixel>(data[7] | (data[8] << 8)),
+            static_cast<u16>(data[9] | (data[10] << 8))};
+
+        if (reader.width < 1 or reader.height < 1) { return Error::BadHeader; }
+
+        // data_size >= header_size проверен выше, вычитание без переполнения
+        if (reader.frameSize() > data_size - snapshot::header_size) { return Error::Truncated; }
+
+        return reader;
+    }
+
+    /// @brief Размер кадра в байтах
+    [[nodiscard]] inline usize frameSize() const noexcept { return width * ((height + 7) / 8); }
+
+    /// @brief Восстановить все кадры от старого к новому
+    /// @param frames_out Буфер на frames * frameSize() байт
+    /// @details Записи идут от старой к новой, поэтому обход назад от последнего кадра потребовал бы
+    /// поиска каждой записи с начала. Вместо этого два прохода вперёд: XOR симметричен, и старейший кадр -
+    /// последний кадр XOR дельты 1..frames-1, а каждый следующий - предыдущий XOR своя дельта
+    [[nodiscard]] Result<u16, Error> decode(u8 *frames_out) const noexcept {
+        if (frames == 0) { return static_cast<u16>(0); }
+
+        const usize size = frameSize();
+        std::memcpy(frames_out, data + snapshot::header_size, size);
+
+        // Кадр 0 = последний кадр XOR дельты 1..frames-1
+        usize offset = snapshot::header_size + size;
+        for (u16 i = 0; i < frames; ++i) {
+            usize delta_size;
+            if (not readEntry(offset, delta_size)) { return Error::Truncated; }
+
+            if (i != 0) {
+                const auto result = frame_delta::apply(data + offset + snapshot::entry_header_size, delta_size, frames_out, size);
+                if (not result.isOk()) { return Error::Corrupted; }
+            }
+
+            offset += snapshot::entry_header_size + delta_size;
+        }
+
+        // Кадр i = кадр i-1 XOR дельта i (записи и дельты проверены первым проходом)
+        offset = snapshot::header_size + size;
+        for (u16 i = 0; i < frames; ++i) {
+            const usize delta_size = data[offset] | (data[offset + 1] << 8);
+
+            if (i != 0) {
+                u8 *target = frames_out + i * size;
+                std::memcpy(target, target - size, size);
+                frame_delta::apply(data + offset + snapshot::entry_header_size, delta_size, target, size);
+            }
+
+            offset += snapshot::entry_header_size + delta_size;
+        }
+
+        return frames;
+    }
+
+private:
+    explicit SnapshotReader(const u8 *data, usize data_size, Pixel width, Pixel height, u16 frames) noexcept :
+        data{data}, data_size{data_size}, width{width}, height{height}, frames{frames} {}
+
+    /// @brief Прочитать длину дельты записи по смещению offset
+    /// @returns false, если выгрузка обрывается
+    [[nodiscard]] bool readEntry(usize offset, usize &delta_size) const noexcept {
+        if (offset + snapshot::entry_header_size > data_size) { return false; }
+
+        delta_size = data[offset] | (data[offset + 1] << 8);
+        return offset + snapshot::entry_header_size + delta_size <= data_size;
+    }
+};
+
+}// namespace kf::gfx
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstring>
+
+#include <kf/Result.hpp>
+#include <kf/units.hpp>
+
+#include "kf/gfx/BitMap.hpp"
+#include "kf/gfx/FrameView.hpp"
+
+
+namespace kf::gfx {
+
+/// @brief Карта плиток 8x8
+/// @details Плитка совпадает со страницей дисплея: 8 байт столбцов.
+/// Без прокрутки внутри плитки ячейка экрана - копия 8 байт плитки,
+/// при прокрутке столбец собирается из двух плиток сдвигом
+/// @details Перерисовываются только ячейки экрана с изменёнными плитками,
+/// смена прокрутки перерисовывает всё
+/// @tparam MapW Ширина карты в плитках
+/// @tparam MapH Высота карты в плитках
+template<Pixel MapW, Pixel MapH> struct TileMap final {
+
+    /// @brief Размер плитки в пикселях
+    static constexpr Pixel tile_size = 8;
+
+    /// @brief Ошибки
+    enum class Error : u8 {
+
+        /// @brief Набор плиток не высотой 8 или ширина не кратна 8
+        BadTileSet,
+
+        /// @brief Плиток больше, чем индексов в ячейке карты (256)
+        TooManyTiles,
+    };
+
+    /// @brief Максимальное количество плиток в наборе (индекс ячейки - u8)
+    static constexpr u16 max_tiles = 256;
+
+private:
+    /// @brief Набор плиток (плитки подряд слева направо)
+    BitMapView tileset;
+
+    /// @brief Количество плиток в наборе
+    u16 tiles_count;
+
+    /// @brief Индексы плиток карты
+    u8 tiles[MapW * MapH]{};
+
+    /// @brief Изменённые плитки карты
+    u8 dirty[(MapW * MapH + 7) / 8]{};
+
+    /// @brief Прокрутка X
+    Pixel scroll_x{0};
+
+    /// @brief Прокрутка Y
+    Pixel scroll_y{0};
+
+    /// @brief Перерисовать все ячейки
+    bool redraw_all{true};
+
+public:
+    /// @brief Создать карту из набора плиток
+    /// @details Карта заполнена плиткой 0
+    [[nodiscard]] static Result<TileMap, Error> create(const BitMapView &tileset) noexcept {
+        if (nullptr == tileset.buffer or tileset.height != tile_size or
+            tileset.width < tile_size or tileset.width % tile_size != 0) {
+            return Error::BadTileSet;
+        }
+        if (tileset.width / tile_size > max_tiles) { return Error::TooManyTiles; }
+
+        return TileMap{tileset};
+    }
+
+    /// @brief Ширина карты в пикселях
+    [[nodiscard]] static constexpr Pixel pixelWidth() noexcept { return MapW * tile_size; }
+
+    /// @brief Высота карты в пикселях
+    [[nodiscard]] static constexpr Pixel pixelHeight() noexcept { return MapH * tile_size; }
+
+    /// @brief Индекс плитки
+    /// @returns 0, если координаты вне карты
+    [[nodiscard]] inline u8 get(Pixel x, Pixel y) const noexcept {
+        if (x < 0 or x >= MapW or y < 0 or y >= MapH) { return 0; }
+        return tiles[y * MapW + x];
+    }
+
+    /// @brief Установить плитку
+    /// @returns false, если координаты или индекс плитки вне диапазона
+    bool set(Pixel x, Pixel y, u8 tile) noexcept {
+        if (x < 0 or x >= MapW or y < 0 or y >= MapH or tile >= tiles_count) { return false; }
+
+        const usize index = y * MapW + x;
+        if (tiles[index] == tile) { return true; }
+
+        tiles[index] = tile;
+        dirty[index >> 3] |= static_cast<u8>(1 << (index & 7));
+        return true;
+    }
+
+    /// @brief Заполнить карту плиткой
+    void fill(u8 tile) noexcept {
+        if (tile >= tiles_count) { return; }
+
+        std::memset(tiles, tile, sizeof(tiles));
+        redraw_all = true;
+    }
+
+    /// @brief Установить прокрутку (положение левого верхнего угла экрана на карте)
+    void scroll(Pixel x, Pixel y) noexcept {
+        if (x == scroll_x and y == scroll_y) { return; }
+
+        scroll_x = x;
+        scroll_y = y;
+        redraw_all = true;
+    }
+
+    /// @brief Перерисовать всё при следующем render()
+    void invalidate() noexcept { redraw_all = true; }
+
+    /// @brief Отрисовать изменённые ячейки
+    /// @details Область вне карты очищается
+    /// @returns Количество отрисованных ячеек экрана
+    usize render(const FrameView &target) noexcept {
+        const auto fine_x = static_cast<Pixel>(scroll_x & (tile_size - 1));
+        const auto fine_y = static_cast<Pixel>(scroll_y & (tile_size - 1));
+        const auto first_x = static_cast<Pixel>(scroll_x >> 3);
+        const auto first_y = static_cast<Pixel>(scroll_y >> 3);
+        const auto cells_x = static_cast<Pixel>((target.width + tile_size - 1) / tile_size);
+        const auto cells_y = static_cast<Pixel>((target.height + tile_size - 1) / tile_size);
+
+        usize drawn = 0;
+
+        for (Pixel cell_y = 0; cell_y < cells_y; ++cell_y) {
+            const auto map_y = static_cast<Pixel>(first_y + cell_y);
+
+            for (Pixel cell_x = 0; cell_x < cells_x; ++cell_x) {
+                const auto map_x = static_cast<Pixel>(first_x + cell_x);
+
+                if (not redraw_all and not isDirty(map_x, map_y, fine_x != 0, fine_y != 0)) { continue; }
+
+                const auto x = static_cast<Pixel>(cell_x * tile_size);
+                const auto y = static_cast<Pixel>(cell_y * tile_size);
+
+                if (fine_x == 0 and fine_y == 0) {
+                    drawTile(target, x, y, map_x, map_y);
+                } else {
+                    drawShifted(target, x, y, static_cast<Pixel>(scroll_x + x), map_y, fine_y);
+                }
+
+                drawn += 1;
+            }
+        }
+
+        std::memset(dirty, 0, sizeof(dirty));
+        redraw_all = false;
+        return drawn;
+    }
+
+private:
+    explicit TileMap(const BitMapView &tileset) noexcept :
+        tileset{tileset}, tiles_count{static_cast<u16>(tileset.width / tile_size)} {}
+
+    /// @brief Столбцы плитки карты (nullptr вне карты)
+    [[nodiscard]] inline const u8 *tileColumns(Pixel map_x, Pixel map_y) const noexcept {
+        if (map_x < 0 or map_x >= MapW or map_y < 0 or map_y >= MapH) { return nullptr; }
+        return tileset.buffer + tiles[map_y * MapW + map_x] * tile_size;
+    }
+
+    [[nodiscard]] inline bool isDirtyTile(Pixel map_x, Pixel map_y) const noexcept {
+        if (map_x < 0 or map_x >= MapW or map_y < 0 or map_y >= MapH) { return false; }
+        const usize index = map_y * MapW + map_x;
+        return dirty[index >> 3] & (1 << (index & 7));
+    }
+
+    /// @brief Ячейка экрана покрывает изменённую плитку
+    [[nodiscard]] bool isDirty(Pixel map_x, Pixel map_y, bool spans_x, bool spans_y) const noexcept {
+        return isDirtyTile(map_x, map_y) or
+               (spans_x and isDirtyTile(static_cast<Pixel>(map_x + 1), map_y)) or
+               (spans_y and isDirtyTile(map_x, static_cast<Pixel>(map_y + 1))) or
+               (spans_x and spans_y and isDirtyTile(static_cast<Pixel>(map_x + 1), static_cast<Pixel>(map_y + 1)));
+    }
+
+    /// @brief Ячейка без сдвига: копия столбцов плитки
+    void drawTile(const FrameView &target, Pixel x, Pixel y, Pixel map_x, Pixel map_y) const noexcept {
+        const u8 *columns = tileColumns(map_x, map_y);
+
+        for (Pixel column = 0; column < tile_size; ++column) {
+            target.writeColumn(
+                static_cast<Pixel>(x + column),
+                y,
+                nullptr == columns ? 0 : columns[column],
+                0xFF);
+        }
+    }
+
+    /// @brief Ячейка со сдвигом: столбец собирается из плиток map_y и map_y + 1
+    void drawShifted(const FrameView &target, Pixel x, Pixel y, Pixel world_x, Pixel map_y, Pixel fine_y) const noexcept {
+        for (Pixel column = 0; column < tile_size; ++column) {
+            const auto wx = static_cast<Pixel>(world_x + column);
+            const auto map_x = static_cast<Pixel>(wx >> 3);
+            const auto tile_column = static_cast<Pixel>(wx & (tile_size - 1));
+
+            const u8 *upper = tileColumns(map_x, map_y);
+            const u8 *lower = tileColumns(map_x, static_cast<Pixel>(map_y + 1));
+
+            const auto bits = static_cast<u16>(
+                (nullptr == upper ? 0 : upper[tile_column]) |
+                ((nullptr == lower ? 0 : lower[tile_column]) << 8));
+
+            target.writeColumn(
+                static_cast<Pixel>(x + column),
+                y,
+                static_cast<u16>(bits >> fine_y),
+                0xFF);
+        }
+    }
+};
+
+}// namespace kf::gfx
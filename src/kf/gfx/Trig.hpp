@@ -0,0 +1,155 @@
+#pragma once
+
+#include <kf/units.hpp>
+
+
+namespace kf::gfx {
+
+/// @brief Тригонометрия в фиксированной точке без плавающей арифметики во время выполнения
+/// @details Угол - двоичные радианы (65536 - полный оборот), отсчитывается от оси X к оси Y
+/// (на экране - по часовой стрелке). Синус и косинус - Q14 (16384 = 1.0).
+/// Таблицы четверти синуса и арктангенса на [0, 1] по 129 точек вычисляются при компиляции,
+/// между точками - линейная интерполяция
+namespace trig {
+
+/// @brief Угол в двоичных радианах
+using Angle = u16;
+
+/// @brief Дробных бит синуса и косинуса
+static constexpr u8 fraction_bits = 14;
+
+/// @brief 1.0 в Q14
+static constexpr i32 one = 1 << fraction_bits;
+
+/// @brief Четверть оборота (90°)
+static constexpr Angle quarter = 0x4000;
+
+/// @brief Пол-оборота (180°)
+static constexpr Angle half = 0x8000;
+
+/// @brief Интервалов таблицы на четверть оборота
+static constexpr u8 table_steps = 128;
+
+/// @brief Таблицы, вычисляемые при компиляции
+struct Tables final {
+
+    /// @brief sin на [0, 90°] в Q14 (последняя точка продублирована для интерполяции)
+    u16 sine[table_steps + 2];
+
+    /// @brief atan(i / 128) в двоичных радианах, [0, 45°]
+    u16 arctangent[table_steps + 2];
+
+    constexpr Tables() noexcept :
+        sine{}, arctangent{} {
+        constexpr double pi = 3.14159265358979323846;
+
+        for (u16 i = 0; i <= table_steps; ++i) {
+            sine[i] = static_cast<u16>(sin(pi / 2 * i / table_steps) * one + 0.5);
+
+            // tan(a) = t методом Ньютона
+            const double t = static_cast<double>(i) / table_steps;
+            double a = t * pi / 4;
+            for (u8 k = 0; k < 8; ++k) {
+                const double s = sin(a);
+                const double c = sin(pi / 2 - a);
+                a -= (s - t * c) / (c + t * s);
+            }
+            arctangent[i] = static_cast<u16>(a / (2 * pi) * 65536 + 0.5);
+        }
+
+        sine[table_steps + 1] = sine[table_steps];
+        arctangent[table_steps + 1] = arctangent[table_steps];
+    }
+
+private:
+    /// @brief Ряд Тейлора, |x| <= pi / 2
+    static constexpr double sin(double x) noexcept {
+        double term = x;
+        double sum = x;
+        for (u8 n = 1; n < 14; ++n) {
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        return sum;
+    }
+};
+
+/// @brief Таблицы
+static constexpr Tables tables{};
+
+/// @brief Линейная интерполяция таблицы, position - 7 бит дроби
+[[nodiscard]] constexpr i32 interpolate(const u16 *table, u16 position) noexcept {
+    const u16 index = position >> 7;
+    const i32 low = table[index];
+    return low + (((table[index + 1] - low) * (position & 0x7F) + 64) >> 7);
+}
+
+/// @brief Синус, Q14
+[[nodiscard]] constexpr i16 sin(Angle angle) noexcept {
+    const auto offset = static_cast<u16>(angle & (quarter - 1));
+    const auto position = static_cast<u16>(angle & quarter ? quarter - offset : offset);
+    const i32 value = interpolate(tables.sine, position);
+    return static_cast<i16>(angle & half ? -value : value);
+}
+
+/// @brief Косинус, Q14
+[[nodiscard]] constexpr i16 cos(Angle angle) noexcept {
+    return sin(static_cast<Angle>(angle + quarter));
+}
+
+/// @brief Угол вектора (x, y)
+/// @details |x|, |y| < 2^17. Для (0, 0) - 0
+[[nodiscard]] constexpr Angle atan2(i32 y, i32 x) noexcept {
+    if (x == 0 and y == 0) { return 0; }
+
+    const auto ax = static_cast<u32>(x < 0 ? -x : x);
+    const auto ay = static_cast<u32>(y < 0 ? -y : y);
+    const bool steep = ay > ax;
+
+    // Отношение меньшего катета к большему, Q14
+    const auto ratio = static_cast<u16>(steep ? (ax << fraction_bits) / ay : (ay << fraction_bits) / ax);
+    auto angle = static_cast<Angle>(interpolate(tables.arctangent, ratio));
+
+    if (steep) { angle = static_cast<Angle>(quarter - angle); }
+    if (x < 0) { angle = static_cast<Angle>(half - angle); }
+    if (y < 0) { angle = static_cast<Angle>(-angle); }
+    return angle;
+}
+
+/// @brief Угол из градусов
+[[nodiscard]] constexpr Angle fromDegrees(i32 degrees) noexcept {
+    const i32 normalized = (degrees % 360 + 360) % 360;
+    return static_cast<Angle>((normalized * 65536 + 180) / 360);
+}
+
+/// @brief Умножение на Q14 с округлением
+[[nodiscard]] constexpr i32 scale(i32 value, i32 factor) noexcept {
+    return (value * factor + (one >> 1)) >> fraction_bits;
+}
+
+/// @brief Поворот на угол
+/// @details sin и cos вычисляются один раз, поворот точки - четыре умножения
+struct Rotation final {
+
+    /// @brief Косинус угла, Q14
+    i16 cosine;
+
+    /// @brief Синус угла, Q14
+    i16 sine;
+
+    explicit constexpr Rotation(Angle angle) noexcept :
+        cosine{cos(angle)}, sine{sin(angle)} {}
+
+    /// @brief X повёрнутой точки
+    [[nodiscard]] constexpr i32 x(i32 x, i32 y) const noexcept {
+        return (x * cosine - y * sine + (one >> 1)) >> fraction_bits;
+    }
+
+    /// @brief Y повёрнутой точки
+    [[nodiscard]] constexpr i32 y(i32 x, i32 y) const noexcept {
+        return (x * sine + y * cosine + (one >> 1)) >> fraction_bits;
+    }
+};
+
+}// namespace trig
+}// namespace kf::gfx
@@ -0,0 +1,180 @@
+// Замер воспроизведения kf::gfx::AnimationPlayer при разной степени сжатия
+//
+// Сборка:
+//   g++ -std=c++17 -O2 -I<KiraFlux-ToolBox>/src -Isrc tools/animation_bench.cpp src/kf/gfx/Font.cpp -o animation_bench
+//
+// Использование:
+//   animation_bench [frames] [key_interval]
+//
+// Синтетические ролики 128x64 от почти статичного до шумового кодируются в памяти так же,
+// как tools/animation_encode.cpp (ключевой кадр каждые key_interval кадров или когда дельта
+// не меньше ключевого кадра). Для каждого ролика выводятся степень сжатия, время кадра
+// при последовательном показе (next) и устойчивый fps, средний диапазон изменённых страниц
+// и время случайного перехода (seek). Каждый показанный кадр сверяется с исходным.
+// Код возврата 1 при расхождении.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <kf/gfx.hpp>
+
+using namespace kf;
+using namespace kf::gfx;
+
+static constexpr Pixel width = 128;
+static constexpr Pixel height = 64;
+static constexpr usize frame_size = width * height / 8;
+
+using Clip = std::vector<std::vector<u8>>;
+
+/// Ролик: кадр i рисуется в буфер, содержащий кадр i - 1
+using Generator = void (*)(Canvas &, u8 *, u32, std::mt19937 &);
+
+/// Круг, движущийся по нижней половине, и счётчик
+static void sprite(Canvas &canvas, u8 *, u32 frame, std::mt19937 &) {
+    canvas.fill(false);
+    const u32 phase = frame % 16;
+    const auto x = static_cast<Pixel>(8 + (frame * 3) % 112);
+    const auto y = static_cast<Pixel>(44 + (phase < 8 ? phase : 15 - phase));
+    canvas.circle(x, y, 6, Canvas::Mode::Fill);
+
+    char text[16];
+    std::snprintf(text, sizeof(text), "%u", static_cast<unsigned>(frame));
+    canvas.setCursor(0, 0);
+    canvas.text(text);
+}
+
+/// Журнал, сдвигающийся на строку текста каждые 8 кадров и на пиксель каждый кадр
+static void scroll(Canvas &canvas, u8 *, u32 frame, std::mt19937 &) {
+    canvas.fill(false);
+    char text[32];
+    for (u32 i = 0; i < 9; ++i) {
+        const u32 entry = frame / 8 + i;
+        std::snprintf(text, sizeof(text), "line %u: value %u", static_cast<unsigned>(entry), static_cast<unsigned>(entry * 7919 % 1000));
+        canvas.setCursor(0, static_cast<Pixel>(i * 8 - frame % 8));
+        canvas.text(text);
+    }
+}
+
+/// Случайные байты: доля изменённых байт кадра в процентах
+template<u32 Percent> static void noise(Canvas &, u8 *buffer, u32, std::mt19937 &rng) {
+    for (usize i = 0; i < frame_size; ++i) {
+        if (rng() % 100 < Percent) { buffer[i] = static_cast<u8>(rng()); }
+    }
+}
+
+static void putU16(std::vector<u8> &out, u16 value) {
+    out.push_back(static_cast<u8>(value));
+    out.push_back(static_cast<u8>(value >> 8));
+}
+
+/// Кодирование ролика (как tools/animation_encode.cpp)
+static std::vector<u8> encode(const Clip &clip, usize key_interval) {
+    std::vector<u8> out(animation::magic, animation::magic + sizeof(animation::magic));
+    out.push_back(animation::version);
+    putU16(out, width);
+    putU16(out, height);
+    putU16(out, static_cast<u16>(clip.size()));
+    putU16(out, 33);
+    out.resize(out.size() + clip.size() * animation::index_entry_size, 0);
+
+    const std::vector<u8> blank(frame_size, 0);
+
+    for (usize i = 0; i < clip.size(); ++i) {
+        const u8 *frame = clip[i].data();
+        const usize key_size = frame_delta::encodedSize(frame, blank.data(), frame_size);
+
+        bool key = i == 0 or (key_interval > 0 and i % key_interval == 0);
+        if (not key) { key = frame_delta::encodedSize(frame, clip[i - 1].data(), frame_size) >= key_size; }
+
+        const usize record = out.size();
+        putU16(out, 0);
+        const usize delta_size = frame_delta::encode(frame, key ? blank.data() : clip[i - 1].data(), frame_size, [&out](u8 b) { out.push_back(b); });
+        out[record] = static_cast<u8>(delta_size);
+        out[record + 1] = static_cast<u8>(delta_size >> 8);
+
+        const u32 entry = static_cast<u32>(record) | (key ? animation::key_frame_flag : 0);
+        for (u8 b = 0; b < 4; ++b) { out[animation::header_size + i * animation::index_entry_size + b] = static_cast<u8>(entry >> (b * 8)); }
+    }
+
+    return out;
+}
+
+struct Scene {
+    const char *name;
+    Generator generate;
+};
+
+int main(int argc, char **argv) {
+    const u32 frames = argc > 1 ? static_cast<u32>(std::strtoul(argv[1], nullptr, 10)) : 120;
+    const usize key_interval = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 32;
+
+    const Scene scenes[] = {
+        {"sprite", sprite},
+        {"scroll", scroll},
+        {"noise 5%", noise<5>},
+        {"noise 25%", noise<25>},
+        {"noise 60%", noise<60>},
+    };
+
+    std::printf("%u frames %dx%d, key interval %zu\n\n", frames, width, height, key_interval);
+    std::printf("%-10s %8s %7s %9s %9s %7s %9s\n", "clip", "bytes", "ratio", "next us", "fps", "pages", "seek us");
+
+    usize mismatches = 0;
+
+    for (const auto &scene: scenes) {
+        // Исходные кадры
+        std::mt19937 rng{1};
+        std::vector<u8> buffer(frame_size, 0);
+        Canvas canvas{FrameView{buffer.data(), width, width, height, 0, 0}, fonts::gyver_5x7_en};
+
+        Clip clip;
+        for (u32 i = 0; i < frames; ++i) {
+            scene.generate(canvas, buffer.data(), i, rng);
+            clip.push_back(buffer);
+        }
+
+        const std::vector<u8> file = encode(clip, key_interval);
+        auto player = AnimationPlayer::create(file.data(), file.size()).ok().value();
+
+        std::vector<u8> display(frame_size, 0);
+        const FrameView target{display.data(), width, width, height, 0, 0};
+
+        // Проверка и диапазон страниц за один проход
+        usize pages = 0;
+        for (u32 i = 0; i < frames; ++i) {
+            const auto range = player.next(target).ok().value();
+            if (not range.empty()) { pages += static_cast<usize>(range.last - range.first + 1); }
+            if (display != clip[i]) { mismatches += 1; }
+        }
+
+        // Последовательный показ: минимум из прогонов всего ролика
+        double best = 1e30;
+        for (int repeat = 0; repeat < 20; ++repeat) {
+            const auto start = std::chrono::steady_clock::now();
+            for (u32 i = 0; i < frames; ++i) { (void) player.next(target); }
+            const auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::micro>(end - start).count());
+        }
+        const double next_us = best / frames;
+
+        // Случайный переход
+        std::mt19937 seek_rng{2};
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < 1000; ++i) { (void) player.seek(static_cast<u16>(seek_rng() % frames), target); }
+        const auto end = std::chrono::steady_clock::now();
+        const double seek_us = std::chrono::duration<double, std::micro>(end - start).count() / 1000;
+
+        const double ratio = static_cast<double>(frames * frame_size) / static_cast<double>(file.size());
+        std::printf("%-10s %8zu %7.1f %9.2f %9.0f %7.1f %9.2f\n",
+                    scene.name, file.size(), ratio, next_us, 1e6 / next_us, static_cast<double>(pages) / frames, seek_us);
+    }
+
+    std::printf("\n%zu frame mismatches\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,214 @@
+// Сборка анимации kf::gfx::AnimationPlayer из кадров PBM
+//
+// Сборка:
+//   g++ -std=c++17 -O2 -I<KiraFlux-ToolBox>/src -Isrc tools/animation_encode.cpp -o animation_encode
+//
+// Использование:
+//   animation_encode [-k key_interval] [-d frame_ms] <out.kfan> <frame.pbm>...
+//
+// Ключевой кадр ставится каждые key_interval кадров (по умолчанию 32, 0 - только первый),
+// а также когда дельта к предыдущему кадру не меньше дельты к пустому кадру.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <kf/gfx/Animation.hpp>
+
+using namespace kf;
+using namespace kf::gfx;
+
+/// Кадр в страничном формате
+struct Frame {
+    Pixel width{0};
+    Pixel height{0};
+    std::vector<u8> pages;
+};
+
+static int readToken(std::FILE *file, char *out, usize capacity) {
+    int c = std::fgetc(file);
+
+    for (;;) {
+        while (c == ' ' or c == '\t' or c == '\r' or c == '\n') { c = std::fgetc(file); }
+        if (c != '#') { break; }
+        while (c != '\n' and c != EOF) { c = std::fgetc(file); }
+    }
+
+    usize length = 0;
+    while (c != EOF and c != ' ' and c != '\t' and c != '\r' and c != '\n' and length + 1 < capacity) {
+        out[length++] = static_cast<char>(c);
+        c = std::fgetc(file);
+    }
+    out[length] = '\0';
+    return static_cast<int>(length);
+}
+
+static bool readPbm(const char *path, Frame &frame) {
+    std::FILE *file = std::fopen(path, "rb");
+    if (nullptr == file) { return false; }
+
+    char token[32];
+    readToken(file, token, sizeof(token));
+    const bool binary = std::strcmp(token, "P4") == 0;
+    if (not binary and std::strcmp(token, "P1") != 0) {
+        std::fclose(file);
+        return false;
+    }
+
+    readToken(file, token, sizeof(token));
+    frame.width = static_cast<Pixel>(std::atoi(token));
+    readToken(file, token, sizeof(token));
+    frame.height = static_cast<Pixel>(std::atoi(token));
+
+    if (frame.width < 1 or frame.height < 1) {
+        std::fclose(file);
+        return false;
+    }
+
+    frame.pages.assign(frame.width * ((frame.height + 7) / 8), 0);
+
+    for (Pixel y = 0; y < frame.height; ++y) {
+        std::vector<u8> row;
+
+        if (binary) {
+            row.resize((frame.width + 7) / 8);
+            if (std::fread(row.data(), 1, row.size(), file) != row.size()) {
+                std::fclose(file);
+                return false;
+            }
+        }
+
+        for (Pixel x = 0; x < frame.width; ++x) {
+            bool on;
+
+            if (binary) {
+                on = row[x >> 3] & (0x80 >> (x & 7));
+            } else {
+                int c;
+                do { c = std::fgetc(file); } while (c != '0' and c != '1' and c != EOF);
+                if (c == EOF) {
+                    std::fclose(file);
+                    return false;
+                }
+                on = c == '1';
+            }
+
+            if (on) { frame.pages[(y >> 3) * frame.width + x] |= 1 << (y & 7); }
+        }
+    }
+
+    std::fclose(file);
+    return true;
+}
+
+static void putU16(std::vector<u8> &out, u16 value) {
+    out.push_back(static_cast<u8>(value));
+    out.push_back(static_cast<u8>(value >> 8));
+}
+
+static void putU32(std::vector<u8> &out, usize at, u32 value) {
+    for (u8 i = 0; i < 4; ++i) { out[at + i] = static_cast<u8>(value >> (i * 8)); }
+}
+
+int main(int argc, char **argv) {
+    usize key_interval = 32;
+    u16 frame_ms = 100;
+    int arg = 1;
+
+    for (; arg + 1 < argc and argv[arg][0] == '-'; arg += 2) {
+        if (std::strcmp(argv[arg], "-k") == 0) {
+            key_interval = static_cast<usize>(std::atoi(argv[arg + 1]));
+        } else if (std::strcmp(argv[arg], "-d") == 0) {
+            frame_ms = static_cast<u16>(std::atoi(argv[arg + 1]));
+        } else {
+            break;
+        }
+    }
+
+    if (argc - arg < 2) {
+        std::fprintf(stderr, "usage: %s [-k key_interval] [-d frame_ms] <out.kfan> <frame.pbm>...\n", argv[0]);
+        return 2;
+    }
+
+    const char *output_path = argv[arg];
+    const int first_frame = arg + 1;
+    const auto frame_count = static_cast<usize>(argc - first_frame);
+
+    if (frame_count > 0xFFFF) {
+        std::fprintf(stderr, "too many frames\n");
+        return 2;
+    }
+
+    std::vector<u8> out(animation::magic, animation::magic + sizeof(animation::magic));
+    out.push_back(animation::version);
+
+    Frame previous;
+    std::vector<u8> blank;
+    usize key_frames = 0;
+    usize raw_size = 0;
+
+    for (usize i = 0; i < frame_count; ++i) {
+        Frame frame;
+        const char *path = argv[first_frame + i];
+
+        if (not readPbm(path, frame)) {
+            std::fprintf(stderr, "%s: cannot read PBM\n", path);
+            return 1;
+        }
+
+        if (i == 0) {
+            putU16(out, static_cast<u16>(frame.width));
+            putU16(out, static_cast<u16>(frame.height));
+            putU16(out, static_cast<u16>(frame_count));
+            putU16(out, frame_ms);
+            out.resize(out.size() + frame_count * animation::index_entry_size, 0);
+            blank.assign(frame.pages.size(), 0);
+        } else if (frame.width != previous.width or frame.height != previous.height) {
+            std::fprintf(stderr, "%s: frame size differs from the first frame\n", path);
+            return 1;
+        }
+
+        const usize size = frame.pages.size();
+        const usize key_size = frame_delta::encodedSize(frame.pages.data(), blank.data(), size);
+
+        bool key = i == 0 or (key_interval > 0 and i % key_interval == 0);
+        if (not key) {
+            key = frame_delta::encodedSize(frame.pages.data(), previous.pages.data(), size) >= key_size;
+        }
+
+        const u8 *base = key ? blank.data() : previous.pages.data();
+        const usize record = out.size();
+
+        putU16(out, 0);
+        const usize delta_size = frame_delta::encode(frame.pages.data(), base, size, [&out](u8 b) { out.push_back(b); });
+
+        if (delta_size > 0xFFFF) {
+            std::fprintf(stderr, "%s: frame delta too large\n", path);
+            return 1;
+        }
+
+        out[record] = static_cast<u8>(delta_size);
+        out[record + 1] = static_cast<u8>(delta_size >> 8);
+
+        putU32(out, animation::header_size + i * animation::index_entry_size,
+               static_cast<u32>(record) | (key ? animation::key_frame_flag : 0));
+
+        key_frames += key ? 1 : 0;
+        raw_size += size;
+        previous = std::move(frame);
+    }
+
+    std::FILE *file = std::fopen(output_path, "wb");
+    if (nullptr == file or std::fwrite(out.data(), 1, out.size(), file) != out.size()) {
+        std::perror(output_path);
+        return 2;
+    }
+    std::fclose(file);
+
+    std::printf("%zu frames (%zu key), %zu bytes, raw %zu bytes, ratio %.2f\n",
+                frame_count, key_frames, out.size(), raw_size,
+                static_cast<double>(raw_size) / static_cast<double>(out.size()));
+    return 0;
+}
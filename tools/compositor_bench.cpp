@@ -0,0 +1,190 @@
+// Замер kf::gfx::Compositor против полной перерисовки кадра в зависимости от количества спрайтов
+//
+// Сборка:
+//   g++ -std=c++17 -O2 -I<KiraFlux-ToolBox>/src -Isrc tools/compositor_bench.cpp src/kf/gfx/Font.cpp -o compositor_bench
+//
+// Использование:
+//   compositor_bench [frames]
+//
+// Фон 128x64 (текст и рамки) неподвижен, спрайты 12x12 движутся каждый кадр и отражаются от краёв.
+// Половина спрайтов с маской непрозрачности, половина накладывается через OR, z задаётся случайно.
+// Для каждого количества спрайтов выводятся:
+//   compose us - move() всех спрайтов и compose() помеченных плиток
+//   tiles      - пересобранных плиток 8x8 за кадр (из 128)
+//   bytes      - байт на отправку за кадр (8 на плитку) против полного кадра 1024
+//   full us    - полная перерисовка: копия фона и drawBitmap всех спрайтов в порядке z
+// Кадр compose() сверяется с полной перерисовкой. Код возврата 1 при расхождении.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <kf/gfx.hpp>
+
+using namespace kf;
+using namespace kf::gfx;
+
+static constexpr Pixel width = 128;
+static constexpr Pixel height = 64;
+static constexpr usize frame_size = width * height / 8;
+static constexpr u8 max_sprites = 64;
+
+using Scene = Compositor<width, height, max_sprites>;
+
+static constexpr Pixel sprite_size = 12;
+
+/// Маска спрайта: круг
+static u8 mask_buffer[sprite_size * 2]{};
+
+/// Изображение спрайта: кольцо с точкой внутри маски
+static u8 image_buffer[sprite_size * 2]{};
+
+static const BitMapView sprite_mask{mask_buffer, sprite_size, sprite_size};
+static const BitMapView sprite_image{image_buffer, sprite_size, sprite_size};
+
+static void makeSprite() {
+    Canvas mask{FrameView{mask_buffer, sprite_size, sprite_size, sprite_size, 0, 0}};
+    mask.circle(5, 5, 5, Canvas::Mode::Fill);
+
+    Canvas image{FrameView{image_buffer, sprite_size, sprite_size, sprite_size, 0, 0}};
+    image.circle(5, 5, 5, Canvas::Mode::FillBorder);
+    image.circle(5, 5, 2, Canvas::Mode::Fill);
+
+    // Изображение внутри маски: маскированный спрайт непрозрачен целиком
+    for (usize i = 0; i < sizeof(mask_buffer); ++i) { mask_buffer[i] = static_cast<u8>(mask_buffer[i] | image_buffer[i]); }
+}
+
+/// Фон: рамка и строки текста
+static void drawBackground(const FrameView &frame) {
+    Canvas canvas{frame, fonts::gyver_5x7_en};
+    canvas.rect(0, 0, width - 1, height - 1, Canvas::Mode::FillBorder);
+    for (Pixel y = 4; y < height - 8; y = static_cast<Pixel>(y + 12)) {
+        canvas.setCursor(4, y);
+        canvas.text("BACKGROUND 0123456789");
+    }
+}
+
+struct Body {
+    Pixel x, y, dx, dy;
+    u8 z;
+    bool masked;
+};
+
+static void step(Body &body) {
+    body.x = static_cast<Pixel>(body.x + body.dx);
+    body.y = static_cast<Pixel>(body.y + body.dy);
+    if (body.x < -6 or body.x > width - 6) { body.dx = static_cast<Pixel>(-body.dx); }
+    if (body.y < -6 or body.y > height - 6) { body.dy = static_cast<Pixel>(-body.dy); }
+}
+
+/// Полная перерисовка: копия фона и спрайты в порядке z (при равном z - в порядке добавления)
+static void drawFull(u8 *frame, const u8 *background, const std::vector<Body> &bodies, const std::vector<usize> &order) {
+    std::memcpy(frame, background, frame_size);
+    FrameView view{frame, width, width, height, 0, 0};
+
+    for (const usize i: order) {
+        const Body &body = bodies[i];
+        if (body.masked) { view.drawBitmap(body.x, body.y, sprite_mask, false); }
+        view.drawBitmap(body.x, body.y, sprite_image, true);
+    }
+}
+
+int main(int argc, char **argv) {
+    const u32 frames = argc > 1 ? static_cast<u32>(std::strtoul(argv[1], nullptr, 10)) : 512;
+    const u8 counts[] = {1, 2, 4, 8, 16, 32, 64};
+
+    std::printf("%u frames %dx%d, sprites 12x12\n\n", frames, width, height);
+    std::printf("%-8s %11s %7s %7s %9s\n", "sprites", "compose us", "tiles", "bytes", "full us");
+
+    makeSprite();
+    usize mismatches = 0;
+
+    for (const u8 sprites: counts) {
+        static Scene scene;
+        scene = Scene{};
+
+        drawBackground(scene.background());
+        scene.invalidateAll();
+
+        std::vector<u8> background(frame_size);
+        drawBackground(FrameView{background.data(), width, width, height, 0, 0});
+
+        std::mt19937 rng{1};
+        std::vector<Body> bodies;
+        std::vector<Scene::SpriteId> ids;
+        for (u8 i = 0; i < sprites; ++i) {
+            Body body{};
+            body.x = static_cast<Pixel>(rng() % (width - sprite_size));
+            body.y = static_cast<Pixel>(rng() % (height - sprite_size));
+            body.dx = static_cast<Pixel>(rng() % 2 == 0 ? 1 : -1);
+            body.dy = static_cast<Pixel>(rng() % 3 == 0 ? -1 : 1);
+            body.z = static_cast<u8>(rng() % 4);
+            body.masked = i % 2 == 0;
+            bodies.push_back(body);
+
+            const BitMapView mask = body.masked ? sprite_mask : BitMapView{nullptr, 0, 0};
+            ids.push_back(scene.add(sprite_image, mask, body.x, body.y, body.z).ok().value());
+        }
+
+        std::vector<usize> order(sprites);
+        for (usize i = 0; i < order.size(); ++i) { order[i] = i; }
+        std::stable_sort(order.begin(), order.end(), [&bodies](usize a, usize b) { return bodies[a].z < bodies[b].z; });
+
+        std::vector<u8> display(frame_size), reference(frame_size);
+        const FrameView target{display.data(), width, width, height, 0, 0};
+        scene.compose(target);
+
+        // Сверка и плитки за кадр
+        const std::vector<Body> start_bodies = bodies;
+        usize tiles = 0;
+        for (u32 frame = 0; frame < frames; ++frame) {
+            for (u8 i = 0; i < sprites; ++i) {
+                step(bodies[i]);
+                scene.move(ids[i], bodies[i].x, bodies[i].y);
+            }
+            tiles += scene.compose(target);
+
+            drawFull(reference.data(), background.data(), bodies, order);
+            if (display != reference) { mismatches += 1; }
+        }
+
+        // Время: минимум из прогонов всех кадров с одной и той же начальной позиции
+        double compose_best = 1e30, full_best = 1e30;
+        for (int repeat = 0; repeat < 5; ++repeat) {
+            bodies = start_bodies;
+            for (u8 i = 0; i < sprites; ++i) { scene.move(ids[i], bodies[i].x, bodies[i].y); }
+            scene.compose(target);
+
+            auto begin = std::chrono::steady_clock::now();
+            for (u32 frame = 0; frame < frames; ++frame) {
+                for (u8 i = 0; i < sprites; ++i) {
+                    step(bodies[i]);
+                    scene.move(ids[i], bodies[i].x, bodies[i].y);
+                }
+                scene.compose(target);
+            }
+            auto end = std::chrono::steady_clock::now();
+            compose_best = std::min(compose_best, std::chrono::duration<double, std::micro>(end - begin).count());
+
+            bodies = start_bodies;
+            begin = std::chrono::steady_clock::now();
+            for (u32 frame = 0; frame < frames; ++frame) {
+                for (auto &body: bodies) { step(body); }
+                drawFull(reference.data(), background.data(), bodies, order);
+            }
+            end = std::chrono::steady_clock::now();
+            full_best = std::min(full_best, std::chrono::duration<double, std::micro>(end - begin).count());
+        }
+
+        const double tiles_per_frame = static_cast<double>(tiles) / frames;
+        std::printf("%-8u %11.2f %7.1f %7.0f %9.2f\n",
+                    sprites, compose_best / frames, tiles_per_frame, tiles_per_frame * 8, full_best / frames);
+    }
+
+    std::printf("\n%zu frame mismatches\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+// Воспроизведение журнала вызовов Canvas на хосте (см. kf::gfx::DrawRecorder)
+//
+// Сборка:
+//   g++ -std=c++17 -O2 -I<KiraFlux-ToolBox>/src -Isrc tools/draw_log_replay.cpp src/kf/gfx/Font.cpp -o draw_log_replay
+//
+// Таблицы шрифтов и битмапов должны совпадать с таблицами, переданными DrawRecorder на устройстве.
+// По умолчанию зарегистрирован только fonts::gyver_5x7_en (id 0). Свои таблицы подключаются через
+//   -DKF_GFX_REPLAY_ASSETS='"assets.hpp"'
+// где assets.hpp определяет replay_fonts[] (const kf::gfx::Font *) и replay_bitmaps[] (kf::gfx::BitMapView).
+//
+// Использование:
+//   draw_log_replay <log.bin> [frame.pbm]
+//   draw_log_replay --self-test
+//
+// --self-test воспроизводит встроенные журналы с областью Frame за границами дисплея
+// (отрицательное смещение, нулевой размер, выход за правый и нижний край): каждый должен
+// завершиться ошибкой FrameOutOfBounds, не изменив буфер кадра.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <kf/gfx.hpp>
+
+using namespace kf;
+using namespace kf::gfx;
+
+#if defined(KF_GFX_REPLAY_ASSETS)
+#include KF_GFX_REPLAY_ASSETS
+#else
+static const Font *const replay_fonts[] = {&fonts::gyver_5x7_en};
+static const BitMapView *const replay_bitmaps = nullptr;
+static constexpr u8 replay_bitmaps_count = 0;
+#endif
+
+#if defined(KF_GFX_REPLAY_ASSETS)
+static constexpr u8 replay_bitmaps_count = sizeof(replay_bitmaps) / sizeof(replay_bitmaps[0]);
+#endif
+
+static constexpr u8 replay_fonts_count = sizeof(replay_fonts) / sizeof(replay_fonts[0]);
+
+static const char *opName(draw_log::Op op) {
+    switch (op) {
+        case draw_log::Op::Frame: return "frame";
+        case draw_log::Op::Fill: return "fill";
+        case draw_log::Op::Dot: return "dot";
+        case draw_log::Op::Line: return "line";
+        case draw_log::Op::Rect: return "rect";
+        case draw_log::Op::Circle: return "circle";
+        case draw_log::Op::Bitmap: return "bitmap";
+        case draw_log::Op::Text: return "text";
+        case draw_log::Op::FrameEnd: return "frame_end";
+        case draw_log::Op::Arc: return "arc";
+        case draw_log::Op::PatternLine: return "pattern_line";
+    }
+    return "?";
+}
+
+static const char *errorName(DrawPlayer::Error error) {
+    switch (error) {
+        case DrawPlayer::Error::BadHeader: return "bad header";
+        case DrawPlayer::Error::UnsupportedVersion: return "unsupported version";
+        case DrawPlayer::Error::BufferNotInit: return "buffer not initialized";
+        case DrawPlayer::Error::Truncated: return "truncated";
+        case DrawPlayer::Error::UnknownOp: return "unknown op";
+        case DrawPlayer::Error::FrameOutOfBounds: return "frame out of bounds";
+        case DrawPlayer::Error::HashMismatch: return "hash mismatch";
+    }
+    return "?";
+}
+
+/// Журнал: заголовок 128x64, запись Frame (x, y, w, h), запись Fill 1
+static std::vector<u8> frameLog(Pixel x, Pixel y, Pixel w, Pixel h) {
+    std::vector<u8> log(draw_log::magic, draw_log::magic + sizeof(draw_log::magic));
+    log.push_back(draw_log::version);
+
+    const Pixel header[] = {128, 64};
+    for (const Pixel value: header) {
+        log.push_back(static_cast<u8>(value));
+        log.push_back(static_cast<u8>(value >> 8));
+    }
+
+    log.push_back(static_cast<u8>(draw_log::Op::Frame));
+    const Pixel frame[] = {x, y, w, h};
+    for (const Pixel value: frame) {
+        log.push_back(static_cast<u8>(value));
+        log.push_back(static_cast<u8>(value >> 8));
+    }
+
+    log.push_back(static_cast<u8>(draw_log::Op::Fill));
+    log.push_back(1);
+    return log;
+}
+
+/// Воспроизведение журналов с областью за границами дисплея
+/// @returns Количество журналов, не отклонённых с FrameOutOfBounds
+static int selfTest() {
+    struct Bounds {
+        Pixel x, y, w, h;
+    };
+
+    const Bounds cases[] = {
+        {-16, -16, 64, 64},
+        {-1, 0, 8, 8},
+        {0, -1, 8, 8},
+        {0, 0, 0, 8},
+        {0, 0, 8, -1},
+        {100, 0, 29, 8},
+        {0, 57, 8, 8},
+    };
+
+    int failures = 0;
+
+    for (const auto &c: cases) {
+        const std::vector<u8> log = frameLog(c.x, c.y, c.w, c.h);
+        std::vector<u8> frame(DrawPlayer::checkHeader(log.data(), log.size()).ok().value(), 0);
+        auto player = DrawPlayer::create(log.data(), log.size(), frame.data(), replay_fonts, replay_fonts_count).ok().value();
+
+        const auto result = player.step();
+        const bool rejected = not result.isOk() and result.error().value() == DrawPlayer::Error::FrameOutOfBounds;
+        const bool untouched = std::all_of(frame.begin(), frame.end(), [](u8 b) { return b == 0; });
+
+        std::printf("frame %d %d %dx%d: %s\n", c.x, c.y, c.w, c.h,
+                    rejected and untouched ? "rejected" : (result.isOk() ? "accepted" : errorName(result.error().value())));
+        if (not(rejected and untouched)) { failures += 1; }
+    }
+
+    return failures;
+}
+
+struct OpStats {
+    usize count{0};
+    double total_us{0};
+    double max_us{0};
+};
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <log.bin> [frame.pbm]\n       %s --self-test\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    if (std::strcmp(argv[1], "--self-test") == 0) { return selfTest() == 0 ? 0 : 1; }
+
+    std::FILE *file = std::fopen(argv[1], "rb");
+    if (nullptr == file) {
+        std::perror(argv[1]);
+        return 2;
+    }
+
+    std::vector<u8> log;
+    for (int c; (c = std::fgetc(file)) != EOF;) { log.push_back(static_cast<u8>(c)); }
+    std::fclose(file);
+
+    // Заголовок проверяется до выделения буфера по его размерам
+    const auto header_result = DrawPlayer::checkHeader(log.data(), log.size());
+    if (not header_result.isOk()) {
+        std::fprintf(stderr, "%s: %s\n", argv[1], errorName(header_result.error().value()));
+        return 1;
+    }
+
+    const Pixel width = draw_log::readPixel(log.data() + 5);
+    const Pixel height = draw_log::readPixel(log.data() + 7);
+    std::vector<u8> frame(header_result.ok().value(), 0);
+
+    auto player_result = DrawPlayer::create(
+        log.data(), log.size(), frame.data(),
+        replay_fonts, replay_fonts_count,
+        replay_bitmaps, replay_bitmaps_count);
+
+    if (not player_result.isOk()) {
+        std::fprintf(stderr, "%s: %s\n", argv[1], errorName(player_result.error().value()));
+        return 1;
+    }
+
+    auto player = player_result.ok().value();
+
+    OpStats stats[16]{};
+    usize frames = 0;
+    usize mismatches = 0;
+
+    while (not player.done()) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto result = player.step();
+        const auto end = std::chrono::steady_clock::now();
+
+        if (not result.isOk()) {
+            const auto error = result.error().value();
+            if (error != DrawPlayer::Error::HashMismatch) {
+                std::fprintf(stderr, "%s: %s\n", argv[1], errorName(error));
+                return 1;
+            }
+
+            std::printf("frame %zu: hash mismatch\n", frames);
+            mismatches += 1;
+            frames += 1;
+            continue;
+        }
+
+        const auto op = result.ok().value();
+        if (op == draw_log::Op::FrameEnd) { frames += 1; }
+
+        auto &s = stats[static_cast<u8>(op) & 0x0F];
+        const double us = std::chrono::duration<double, std::micro>(end - start).count();
+        s.count += 1;
+        s.total_us += us;
+        if (us > s.max_us) { s.max_us = us; }
+    }
+
+    std::printf("display %dx%d, %zu bytes, %zu frames, %zu hash mismatches\n", width, height, log.size(), frames, mismatches);
+    std::printf("%-10s %8s %12s %10s %10s\n", "op", "count", "total us", "avg us", "max us");
+
+    for (u8 i = 0; i < 16; ++i) {
+        const auto &s = stats[i];
+        if (s.count == 0) { continue; }
+        std::printf("%-10s %8zu %12.2f %10.3f %10.3f\n",
+                    opName(static_cast<draw_log::Op>(i)), s.count, s.total_us, s.total_us / s.count, s.max_us);
+    }
+
+    if (argc > 2) {
+        std::FILE *out = std::fopen(argv[2], "wb");
+        if (nullptr == out) {
+            std::perror(argv[2]);
+            return 2;
+        }
+
+        std::fprintf(out, "P1\n%d %d\n", width, height);
+        for (Pixel y = 0; y < height; ++y) {
+            for (Pixel x = 0; x < width; ++x) {
+                const bool on = frame[(y >> 3) * width + x] & (1 << (y & 7));
+                std::fputc(on ? '1' : '0', out);
+            }
+            std::fputc('\n', out);
+        }
+        std::fclose(out);
+    }
+
+    return mismatches == 0 ? 0 : 1;
+}
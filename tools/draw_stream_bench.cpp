@@ -0,0 +1,255 @@
+// Замер потока команд Canvas (DrawRecorder -> DrawInterpreter) против передачи кадров
+//
+// Сборка:
+//   g++ -std=c++17 -O2 -I<KiraFlux-ToolBox>/src -Isrc tools/draw_stream_bench.cpp src/kf/gfx/Font.cpp -o draw_stream_bench
+//
+// Использование:
+//   draw_stream_bench [frames] [baud]
+//
+// Хост рисует типовые экраны 128x64 на Canvas с DrawRecorder, поток по кадрам (clear() после
+// каждого кадра) передаётся в DrawInterpreter побайтово, как с UART. Кадр приёмника сверяется
+// с кадром хоста. Для каждого экрана выводятся байты на линии за кадр (команды и FrameEnd с хешем),
+// отношение к сырому кадру, время передачи на скорости baud (8N1) и время исполнения приёмником.
+// Затем потоки с областью Frame за границами дисплея должны отклоняться с FrameOutOfBounds без записи в буфер.
+// Код возврата 1, если кадр приёмника расходится с кадром хоста или недопустимая область принята.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <kf/gfx.hpp>
+
+using namespace kf;
+using namespace kf::gfx;
+
+static constexpr Pixel display_width = 128;
+static constexpr Pixel display_height = 64;
+static constexpr usize frame_size = display_width * display_height / 8;
+
+static const BitMap<8, 8> icon_battery{{0x7E, 0x42, 0x5A, 0x5A, 0x5A, 0x42, 0x7E, 0x18}};
+static const BitMap<8, 8> icon_signal{{0xC0, 0x00, 0xF0, 0x00, 0xFC, 0x00, 0xFF, 0x00}};
+static const BitMap<8, 8> icon_gear{{0x18, 0x7E, 0x66, 0xC3, 0xC3, 0x66, 0x7E, 0x18}};
+static const BitMap<8, 8> icon_bell{{0x30, 0x3C, 0x3E, 0xBF, 0xBF, 0x3E, 0x3C, 0x30}};
+
+static const Font *const fonts_table[] = {&fonts::gyver_5x7_en};
+static const BitMapView bitmaps_table[] = {icon_battery.view(), icon_signal.view(), icon_gear.view(), icon_bell.view()};
+
+/// Панель: заголовок, три панели со значениями, окружность и линия
+static void dashboard(Canvas &root, u32 frame) {
+    char line[24];
+    auto rows = root.splitVertically<2>({1, 4});
+
+    std::snprintf(line, sizeof(line), "UPTIME %u", static_cast<unsigned>(frame));
+    rows[0].setCursor(0, 0);
+    rows[0].text(line);
+    rows[0].bitmap(static_cast<Pixel>(rows[0].width() - 9), 0, icon_battery);
+
+    auto panels = rows[1].splitHorizontally<3>({1, 1, 1});
+    for (u32 i = 0; i < panels.size(); ++i) {
+        auto &panel = panels[i];
+        panel.rect(0, 0, panel.maxX(), panel.maxY(), Canvas::Mode::FillBorder);
+
+        std::snprintf(line, sizeof(line), "%u", static_cast<unsigned>((frame * (i + 3) + i * 17) % 100));
+        panel.setCursor(2, 2);
+        panel.text(line);
+    }
+
+    panels[2].circle(panels[2].centerX(), static_cast<Pixel>(panels[2].centerY() + 6), 10, Canvas::Mode::FillBorder);
+    panels[2].line(panels[2].centerX(), static_cast<Pixel>(panels[2].centerY() + 6), static_cast<Pixel>(panels[2].centerX() + static_cast<Pixel>(frame % 9) - 4), static_cast<Pixel>(panels[2].centerY() - 2));
+}
+
+/// Меню: видимые пункты, выделенный пункт инвертирован
+static void menu(Canvas &root, u32 frame) {
+    static constexpr u32 items = 24;
+    const u32 visible = 7;
+    const u32 selected = frame % items;
+    const u32 first = selected < visible ? 0 : selected - visible + 1;
+    char line[24];
+
+    for (u32 i = 0; i < visible; ++i) {
+        const auto y = static_cast<Pixel>(i * 9);
+        const bool active = first + i == selected;
+        if (active) { root.rect(0, y, static_cast<Pixel>(root.maxX() - 4), static_cast<Pixel>(y + 8), Canvas::Mode::Fill); }
+
+        std::snprintf(line, sizeof(line), "Item %u", static_cast<unsigned>(first + i));
+        root.setCursor(2, static_cast<Pixel>(y + 1));
+        root.text(line, not active);
+    }
+
+    const auto bar_y = static_cast<Pixel>((root.height() - 18) * selected / (items - 1));
+    root.rect(static_cast<Pixel>(root.maxX() - 2), bar_y, root.maxX(), static_cast<Pixel>(bar_y + 17), Canvas::Mode::Fill);
+}
+
+/// График: ломаная из 16 отрезков
+static void chart(Canvas &root, u32 frame) {
+    root.line(0, root.maxY(), root.maxX(), root.maxY());
+    root.line(0, 0, 0, root.maxY());
+
+    const auto sample = [frame](u32 i) {
+        const u32 phase = (frame + i * 5) % 64;
+        return static_cast<Pixel>(60 - (phase < 32 ? phase : 63 - phase) * 56 / 31);
+    };
+
+    for (u32 i = 0; i < 16; ++i) {
+        root.line(static_cast<Pixel>(i * 8), sample(i), static_cast<Pixel>(i * 8 + 8), sample(i + 1));
+    }
+}
+
+/// Журнал: 8 строк текста
+static void log(Canvas &root, u32 frame) {
+    char line[24];
+    for (u32 i = 0; i < 8; ++i) {
+        const u32 entry = frame + i;
+        std::snprintf(line, sizeof(line), "[%05u] ev %c%u", static_cast<unsigned>(entry * 37 % 100000), 'A' + static_cast<char>(entry % 26), static_cast<unsigned>(entry % 1000));
+        root.setCursor(0, static_cast<Pixel>(i * 8));
+        root.text(line);
+    }
+}
+
+/// Сетка значков по id с рамкой выбора
+static void icons(Canvas &root, u32 frame) {
+    const BitMap<8, 8> *set[] = {&icon_battery, &icon_signal, &icon_gear, &icon_bell};
+    const u32 selected = frame % 24;
+
+    for (u32 i = 0; i < 24; ++i) {
+        const auto x = static_cast<Pixel>(i % 8 * 16);
+        const auto y = static_cast<Pixel>(i / 8 * 16);
+        root.bitmap(static_cast<Pixel>(x + 4), static_cast<Pixel>(y + 4), *set[i % 4]);
+        if (i == selected) { root.rect(x, y, static_cast<Pixel>(x + 15), static_cast<Pixel>(y + 15), Canvas::Mode::FillBorder); }
+    }
+}
+
+/// Поток: заголовок 128x64, Frame (x, y, w, h), Fill 1
+static std::vector<u8> frameStream(Pixel x, Pixel y, Pixel w, Pixel h) {
+    std::vector<u8> stream(draw_log::magic, draw_log::magic + sizeof(draw_log::magic));
+    stream.push_back(draw_log::version);
+
+    const Pixel values[] = {display_width, display_height};
+    for (const Pixel value: values) {
+        stream.push_back(static_cast<u8>(value));
+        stream.push_back(static_cast<u8>(value >> 8));
+    }
+
+    stream.push_back(static_cast<u8>(draw_log::Op::Frame));
+    const Pixel frame[] = {x, y, w, h};
+    for (const Pixel value: frame) {
+        stream.push_back(static_cast<u8>(value));
+        stream.push_back(static_cast<u8>(value >> 8));
+    }
+
+    stream.push_back(static_cast<u8>(draw_log::Op::Fill));
+    stream.push_back(1);
+    return stream;
+}
+
+/// Области за границами дисплея
+/// @returns Количество принятых недопустимых областей
+static usize checkFrameBounds() {
+    struct Bounds {
+        Pixel x, y, w, h;
+    };
+
+    const Bounds cases[] = {
+        {-16, -16, 64, 64},
+        {-1, 0, 8, 8},
+        {0, -1, 8, 8},
+        {0, 0, 0, 8},
+        {0, 0, 8, -8},
+        {96, 0, 64, 8},
+        {0, 60, 8, 8},
+        {127, 63, 2, 1},
+    };
+
+    usize accepted = 0;
+
+    for (const auto &c: cases) {
+        std::vector<u8> device(frame_size, 0);
+        auto interpreter = DrawInterpreter::create(device.data(), display_width, display_height, fonts_table, 1, bitmaps_table, 4).ok().value();
+
+        const std::vector<u8> stream = frameStream(c.x, c.y, c.w, c.h);
+        const auto result = interpreter.feed(stream.data(), stream.size());
+
+        const bool rejected = not result.isOk() and result.error().value() == DrawInterpreter::Error::FrameOutOfBounds;
+        const bool untouched = std::all_of(device.begin(), device.end(), [](u8 b) { return b == 0; });
+        if (rejected and untouched) { continue; }
+
+        accepted += 1;
+        std::printf("frame %d %d %dx%d accepted\n", c.x, c.y, c.w, c.h);
+    }
+
+    return accepted;
+}
+
+struct Screen {
+    const char *name;
+    void (*draw)(Canvas &, u32);
+};
+
+int main(int argc, char **argv) {
+    const u32 frames = argc > 1 ? static_cast<u32>(std::strtoul(argv[1], nullptr, 10)) : 256;
+    const double baud = argc > 2 ? std::strtod(argv[2], nullptr) : 115200.0;
+    const double byte_us = 10.0 * 1e6 / baud;
+
+    const Screen screens[] = {
+        {"dashboard", dashboard},
+        {"menu", menu},
+        {"chart", chart},
+        {"log", log},
+        {"icons", icons},
+    };
+
+    std::printf("raw frame %zu bytes, %.0f baud: %.0f us per raw frame\n\n", frame_size, baud, frame_size * byte_us);
+    std::printf("%-10s %10s %8s %10s %12s\n", "screen", "bytes", "ratio", "wire us", "execute us");
+
+    usize mismatches = 0;
+
+    for (const auto &screen: screens) {
+        std::vector<u8> host(frame_size), device(frame_size);
+        std::vector<u8> wire(4096);
+
+        DrawRecorder recorder{wire.data(), wire.size(), fonts_table, 1, bitmaps_table, 4};
+        Canvas canvas{FrameView{host.data(), display_width, display_width, display_height, 0, 0}, fonts::gyver_5x7_en};
+        canvas.recorder = &recorder;
+
+        auto interpreter = DrawInterpreter::create(device.data(), display_width, display_height, fonts_table, 1, bitmaps_table, 4).ok().value();
+
+        // Заголовок передаётся один раз за сеанс
+        recorder.begin(display_width, display_height);
+        interpreter.feed(recorder.data(), recorder.size());
+
+        usize bytes = 0;
+        double execute_us = 0;
+
+        for (u32 frame = 0; frame < frames; ++frame) {
+            recorder.clear();
+            canvas.fill(false);
+            screen.draw(canvas, frame);
+            recorder.frameEnd(host.data(), host.size());
+            bytes += recorder.size();
+
+            // Побайтовая подача, минимум из повторов (повтор кадра даёт тот же буфер)
+            double best = 1e30;
+            for (int repeat = 0; repeat < 3; ++repeat) {
+                const auto start = std::chrono::steady_clock::now();
+                for (usize i = 0; i < recorder.size(); ++i) { interpreter.feed(recorder.data()[i]); }
+                const auto end = std::chrono::steady_clock::now();
+                best = std::min(best, std::chrono::duration<double, std::micro>(end - start).count());
+            }
+            execute_us += best;
+
+            if (device != host) { mismatches += 1; }
+        }
+
+        const double per_frame = static_cast<double>(bytes) / frames;
+        std::printf("%-10s %10.1f %7.1fx %10.0f %12.2f\n",
+                    screen.name, per_frame, frame_size / per_frame, per_frame * byte_us, execute_us / frames);
+    }
+
+    const usize accepted = checkFrameBounds();
+
+    std::printf("\n%zu frame mismatches, %zu out-of-bounds frames accepted\n", mismatches, accepted);
+    return mismatches == 0 and accepted == 0 ? 0 : 1;
+}
@@ -0,0 +1,293 @@
+// Дифференциальная проверка быстрых путей FrameView и Canvas по эталону на setPixel
+//
+// Сборка:
+//   g++ -std=c++17 -O2 -I<KiraFlux-ToolBox>/src -Isrc tools/gfx_fuzz.cpp src/kf/gfx/Font.cpp -o gfx_fuzz
+//
+// Использование:
+//   gfx_fuzz [iterations] [seed]
+//
+// Каждая итерация создаёт дисплей случайного размера, дочернюю область со случайным смещением
+// и примитив со случайными координатами (в том числе за границами области). Примитив рисуется
+// быстрым путём и эталоном на setPixel в два одинаковых буфера, буферы должны совпасть побайтово,
+// включая защитные байты за концом буфера. Затем для каждого примитива замеряется ускорение
+// на дисплее 128x64. Код возврата 1 при расхождении.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <kf/gfx.hpp>
+
+using namespace kf;
+using namespace kf::gfx;
+
+/// Защитные байты за концом буфера
+static constexpr usize guard_size = 16;
+
+/// Значение защитных байт
+static constexpr u8 guard_value = 0xA5;
+
+enum class Primitive : u8 {
+    HorizontalSpan,
+    VerticalSpan,
+    Column,
+    Glyph,
+    Bitmap,
+    Fill,
+    RectFill,
+    Count,
+};
+
+static const char *primitiveName(Primitive primitive) {
+    switch (primitive) {
+        case Primitive::HorizontalSpan: return "hspan";
+        case Primitive::VerticalSpan: return "vspan";
+        case Primitive::Column: return "column";
+        case Primitive::Glyph: return "glyph";
+        case Primitive::Bitmap: return "bitmap";
+        case Primitive::Fill: return "fill";
+        case Primitive::RectFill: return "rect fill";
+        case Primitive::Count: break;
+    }
+    return "?";
+}
+
+/// Случайные параметры примитива
+struct Case {
+    Primitive primitive;
+    Pixel x0, y0, x1, y1;
+    bool on;
+    u16 bits, mask;
+    FrameView::RasterOp op;
+    char c;
+    Pixel bitmap_width, bitmap_height;
+    std::vector<u8> bitmap;
+};
+
+static Case randomCase(std::mt19937 &rng, Primitive primitive, const FrameView &frame) {
+    const auto coordinate = [&rng](Pixel size) {
+        return static_cast<Pixel>(static_cast<int>(rng() % (size + 40)) - 20);
+    };
+
+    Case c{};
+    c.primitive = primitive;
+    c.x0 = coordinate(frame.width);
+    c.y0 = coordinate(frame.height);
+    c.x1 = coordinate(frame.width);
+    c.y1 = coordinate(frame.height);
+    c.on = rng() & 1;
+    c.bits = static_cast<u16>(rng());
+    c.mask = static_cast<u16>(rng());
+    c.op = static_cast<FrameView::RasterOp>(rng() % 4);
+    c.c = static_cast<char>(32 + rng() % 95);
+
+    // Курсор за maxGlyphX / maxGlyphY - перенос строки, а не вывод глифа
+    if (primitive == Primitive::Glyph) {
+        const Font &font = fonts::gyver_5x7_en;
+        c.x0 = std::min(c.x0, static_cast<Pixel>(frame.width - font.glyph_width));
+        c.y0 = std::min(c.y0, static_cast<Pixel>(frame.height - font.glyph_height));
+    }
+
+    c.bitmap_width = static_cast<Pixel>(1 + rng() % 40);
+    c.bitmap_height = static_cast<Pixel>(1 + rng() % 30);
+    c.bitmap.resize(static_cast<usize>(c.bitmap_width) * ((c.bitmap_height + 7) / 8));
+    for (auto &b: c.bitmap) { b = static_cast<u8>(rng()); }
+    return c;
+}
+
+/// Быстрый путь
+static void drawFast(FrameView frame, const Case &c) {
+    switch (c.primitive) {
+        case Primitive::HorizontalSpan: frame.drawHorizontalSpan(c.x0, c.x1, c.y0, c.on); return;
+        case Primitive::VerticalSpan: frame.drawVerticalSpan(c.x0, c.y0, c.y1, c.on); return;
+        case Primitive::Column: frame.writeColumn(c.x0, c.y0, c.bits, c.mask, c.op); return;
+
+        case Primitive::Glyph: {
+            Canvas canvas{frame, fonts::gyver_5x7_en};
+            canvas.setCursor(c.x0, c.y0);
+            const char text[2] = {c.c, '\0'};
+            canvas.text(text, c.on);
+            return;
+        }
+
+        case Primitive::Bitmap:
+            frame.drawBitmap(c.x0, c.y0, BitMapView{c.bitmap.data(), c.bitmap_width, c.bitmap_height}, c.on);
+            return;
+
+        case Primitive::Fill: frame.fill(c.on); return;
+
+        case Primitive::RectFill: {
+            Canvas canvas{frame};
+            canvas.rect(c.x0, c.y0, c.x1, c.y1, c.on ? Canvas::Mode::Fill : Canvas::Mode::Clear);
+            return;
+        }
+
+        case Primitive::Count: return;
+    }
+}
+
+/// Эталон: только setPixel / getPixel
+static void drawReference(const FrameView &frame, const Case &c) {
+    switch (c.primitive) {
+        case Primitive::HorizontalSpan:
+            for (int x = std::min(c.x0, c.x1); x <= std::max(c.x0, c.x1); ++x) { frame.setPixel(static_cast<Pixel>(x), c.y0, c.on); }
+            return;
+
+        case Primitive::VerticalSpan:
+            for (int y = std::min(c.y0, c.y1); y <= std::max(c.y0, c.y1); ++y) { frame.setPixel(c.x0, static_cast<Pixel>(y), c.on); }
+            return;
+
+        case Primitive::Column:
+            for (int i = 0; i < 16; ++i) {
+                if (not((c.mask >> i) & 1)) { continue; }
+
+                const auto y = static_cast<Pixel>(c.y0 + i);
+                const bool bit = (c.bits >> i) & 1;
+                const bool old = frame.getPixel(c.x0, y);
+                bool value = bit;
+                if (c.op == FrameView::RasterOp::Or) { value = old or bit; }
+                if (c.op == FrameView::RasterOp::Clear) { value = old and not bit; }
+                if (c.op == FrameView::RasterOp::Xor) { value = old != bit; }
+                frame.setPixel(c.x0, y, value);
+            }
+            return;
+
+        case Primitive::Glyph: {
+            // Глиф непрозрачный: столбцы глифа со строкой интервала под ними и столбец интервала справа
+            const Font &font = fonts::gyver_5x7_en;
+            const u8 *glyph = font.getGlyph(c.c);
+            for (int column = 0; column < font.glyph_width; ++column) {
+                for (int row = 0; row <= font.glyph_height; ++row) {
+                    const bool bit = row < 8 and ((glyph[column] >> row) & 1);
+                    frame.setPixel(static_cast<Pixel>(c.x0 + column), static_cast<Pixel>(c.y0 + row), bit == c.on);
+                }
+            }
+
+            const auto spacing = static_cast<Pixel>(c.x0 + font.glyph_width);
+            if (spacing < frame.width) {
+                for (int row = 0; row <= font.glyph_height; ++row) { frame.setPixel(spacing, static_cast<Pixel>(c.y0 + row), not c.on); }
+            }
+            return;
+        }
+
+        case Primitive::Bitmap:
+            // Битмап прозрачный: записываются только включённые биты
+            for (int bx = 0; bx < c.bitmap_width; ++bx) {
+                for (int by = 0; by < c.bitmap_height; ++by) {
+                    if ((c.bitmap[(by >> 3) * c.bitmap_width + bx] >> (by & 7)) & 1) {
+                        frame.setPixel(static_cast<Pixel>(c.x0 + bx), static_cast<Pixel>(c.y0 + by), c.on);
+                    }
+                }
+            }
+            return;
+
+        case Primitive::Fill:
+            for (Pixel y = 0; y < frame.height; ++y) {
+                for (Pixel x = 0; x < frame.width; ++x) { frame.setPixel(x, y, c.on); }
+            }
+            return;
+
+        case Primitive::RectFill:
+            for (int y = std::min(c.y0, c.y1); y <= std::max(c.y0, c.y1); ++y) {
+                for (int x = std::min(c.x0, c.x1); x <= std::max(c.x0, c.x1); ++x) {
+                    frame.setPixel(static_cast<Pixel>(x), static_cast<Pixel>(y), c.on);
+                }
+            }
+            return;
+
+        case Primitive::Count: return;
+    }
+}
+
+/// Случайная проверка
+/// @returns Количество расхождений
+static usize fuzz(std::mt19937 &rng, usize iterations, usize *checked) {
+    usize mismatches = 0;
+
+    for (usize i = 0; i < iterations; ++i) {
+        const auto display_width = static_cast<Pixel>(1 + rng() % 160);
+        const auto display_height = static_cast<Pixel>(1 + rng() % 72);
+        const usize size = static_cast<usize>(display_width) * ((display_height + 7) / 8);
+
+        std::vector<u8> fast(size + guard_size);
+        for (usize j = 0; j < size; ++j) { fast[j] = static_cast<u8>(rng()); }
+        std::fill(fast.begin() + static_cast<long>(size), fast.end(), guard_value);
+        std::vector<u8> reference = fast;
+
+        // Дочерняя область в пределах дисплея
+        const auto sub_x = static_cast<Pixel>(rng() % display_width);
+        const auto sub_y = static_cast<Pixel>(rng() % display_height);
+        const auto sub_width = static_cast<Pixel>(1 + rng() % (display_width - sub_x));
+        const auto sub_height = static_cast<Pixel>(1 + rng() % (display_height - sub_y));
+
+        const FrameView fast_frame{fast.data(), display_width, sub_width, sub_height, sub_x, sub_y};
+        const FrameView reference_frame{reference.data(), display_width, sub_width, sub_height, sub_x, sub_y};
+
+        const auto primitive = static_cast<Primitive>(i % static_cast<usize>(Primitive::Count));
+        const Case c = randomCase(rng, primitive, fast_frame);
+
+        drawFast(fast_frame, c);
+        drawReference(reference_frame, c);
+        checked[static_cast<usize>(primitive)] += 1;
+
+        if (fast != reference) {
+            mismatches += 1;
+            std::printf(
+                "mismatch: %s display %dx%d view %dx%d+%d+%d args %d %d %d %d on %d\n",
+                primitiveName(primitive), display_width, display_height, sub_width, sub_height, sub_x, sub_y,
+                c.x0, c.y0, c.x1, c.y1, c.on);
+        }
+    }
+
+    return mismatches;
+}
+
+/// Время выполнения набора примитивов, минимум из нескольких повторов
+template<typename F> static double measure(const std::vector<Case> &cases, F draw) {
+    double best = 1e30;
+
+    for (int repeat = 0; repeat < 7; ++repeat) {
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto &c: cases) { draw(c); }
+        const auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+    }
+
+    return best / static_cast<double>(cases.size());
+}
+
+int main(int argc, char **argv) {
+    const usize iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const auto seed = static_cast<u32>(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1);
+
+    std::mt19937 rng{seed};
+    usize checked[static_cast<usize>(Primitive::Count)]{};
+    const usize mismatches = fuzz(rng, iterations, checked);
+
+    std::printf("%zu cases, seed %u, %zu mismatches\n\n", iterations, seed, mismatches);
+    std::printf("%-10s %8s %12s %12s %9s\n", "primitive", "cases", "fast ns", "setPixel ns", "speedup");
+
+    // Замер на полном дисплее 128x64
+    std::vector<u8> buffer(128 * 8);
+    const FrameView frame{buffer.data(), 128, 128, 64, 0, 0};
+
+    for (u8 p = 0; p < static_cast<u8>(Primitive::Count); ++p) {
+        const auto primitive = static_cast<Primitive>(p);
+        const usize count = primitive == Primitive::Fill ? 64 : 4096;
+
+        std::vector<Case> cases;
+        for (usize i = 0; i < count; ++i) { cases.push_back(randomCase(rng, primitive, frame)); }
+
+        const double fast_ns = measure(cases, [&frame](const Case &c) { drawFast(frame, c); });
+        const double reference_ns = measure(cases, [&frame](const Case &c) { drawReference(frame, c); });
+
+        std::printf("%-10s %8zu %12.1f %12.1f %8.1fx\n",
+                    primitiveName(primitive), checked[p], fast_ns, reference_ns, reference_ns / fast_ns);
+    }
+
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+// Макро-замер типовых кадров на Canvas
+//
+// Сборка:
+//   g++ -std=c++17 -O2 -I<KiraFlux-ToolBox>/src -Isrc tools/gfx_scenarios.cpp src/kf/gfx/Font.cpp -o gfx_scenarios
+//
+// Использование:
+//   gfx_scenarios [frames]
+//
+// Сценарии: панель приборов (splitVertically / splitHorizontally), прокручиваемое меню,
+// график в реальном времени, журнал текста, сетка значков. Каждый кадр очищается и рисуется
+// заново, как в приложениях. Для каждого сценария и размера дисплея выводятся:
+//   frame us  - время отрисовки кадра (минимум из нескольких прогонов, среднее по кадрам)
+//   modified  - байт буфера, изменившихся относительно предыдущего кадра
+//   flush     - байт частичной отправки: на каждой странице от первого до последнего изменённого столбца
+//   full      - размер полного кадра
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <kf/gfx/BitMap.hpp>
+#include <kf/gfx/Canvas.hpp>
+#include <kf/gfx/Font.hpp>
+
+using namespace kf;
+using namespace kf::gfx;
+
+static const BitMap<8, 8> icon_battery{{0x7E, 0x42, 0x5A, 0x5A, 0x5A, 0x42, 0x7E, 0x18}};
+static const BitMap<8, 8> icon_signal{{0xC0, 0x00, 0xF0, 0x00, 0xFC, 0x00, 0xFF, 0x00}};
+static const BitMap<8, 8> icon_gear{{0x18, 0x7E, 0x66, 0xC3, 0xC3, 0x66, 0x7E, 0x18}};
+static const BitMap<8, 8> icon_bell{{0x30, 0x3C, 0x3E, 0xBF, 0xBF, 0x3E, 0x3C, 0x30}};
+
+/// Десятичная запись числа
+static void format(char *out, const char *prefix, u32 value) {
+    std::snprintf(out, 24, "%s%u", prefix, static_cast<unsigned>(value));
+}
+
+/// Панель: заголовок и три панели со значениями и полосами
+static void dashboard(Canvas &root, u32 frame) {
+    char line[24];
+    auto rows = root.splitVertically<2>({1, 4});
+
+    rows[0].setCursor(0, 0);
+    format(line, "UPTIME ", frame);
+    rows[0].text(line);
+    rows[0].bitmap(static_cast<Pixel>(rows[0].width() - 9), 0, icon_battery);
+
+    auto panels = rows[1].splitHorizontally<3>({1, 1, 1});
+    for (u32 i = 0; i < panels.size(); ++i) {
+        auto &panel = panels[i];
+        panel.rect(0, 0, panel.maxX(), panel.maxY(), Canvas::Mode::FillBorder);
+
+        const u32 value = (frame * (i + 3) + i * 17) % 100;
+        panel.setCursor(2, 2);
+        format(line, "", value);
+        panel.text(line);
+
+        const auto level = static_cast<Pixel>(value * (panel.width() - 5) / 100);
+        if (level > 0) { panel.rect(2, panel.maxY() - 3, static_cast<Pixel>(2 + level), static_cast<Pixel>(panel.maxY() - 2), Canvas::Mode::Fill); }
+    }
+}
+
+/// Меню: прокрутка списка, выделенный пункт инвертирован, полоса прокрутки
+static void menu(Canvas &root, u32 frame) {
+    static constexpr u32 items = 24;
+    const Pixel row_height = 9;
+    const auto visible = static_cast<u32>(std::max(1, root.height() / row_height));
+    const u32 selected = frame % items;
+    const u32 first = selected < visible ? 0 : selected - visible + 1;
+
+    char line[24];
+    for (u32 i = 0; i < visible and first + i < items; ++i) {
+        const auto y = static_cast<Pixel>(i * row_height);
+        const bool active = first + i == selected;
+
+        if (active) { root.rect(0, y, static_cast<Pixel>(root.maxX() - 4), static_cast<Pixel>(y + row_height - 1), Canvas::Mode::Fill); }
+
+        root.setCursor(2, static_cast<Pixel>(y + 1));
+        format(line, "Item ", first + i);
+        root.text(line, not active);
+    }
+
+    const auto bar = static_cast<Pixel>(root.height() * visible / items);
+    const auto bar_y = static_cast<Pixel>((root.height() - bar) * selected / (items - 1));
+    root.line(root.maxX(), 0, root.maxX(), root.maxY());
+    root.rect(static_cast<Pixel>(root.maxX() - 2), bar_y, root.maxX(), static_cast<Pixel>(bar_y + bar - 1), Canvas::Mode::Fill);
+}
+
+/// График: оси, подпись и ломаная, сдвигающаяся на столбец за кадр
+static void chart(Canvas &root, u32 frame) {
+    const Pixel left = 12;
+    const auto bottom = static_cast<Pixel>(root.maxY() - 1);
+
+    root.line(left, 0, left, bottom);
+    root.line(left, bottom, root.maxX(), bottom);
+
+    char line[24];
+    root.setCursor(0, 0);
+    format(line, "", frame % 100);
+    root.text(line);
+
+    const auto sample = [&](u32 t) {
+        const u32 phase = t % 64;
+        const u32 triangle = phase < 32 ? phase : 63 - phase;
+        return static_cast<Pixel>(bottom - 1 - triangle * (bottom - 2) / 31);
+    };
+
+    for (Pixel x = left + 1; x < root.maxX(); ++x) {
+        root.line(x, sample(frame + x), static_cast<Pixel>(x + 1), sample(frame + x + 1));
+    }
+}
+
+/// Журнал: строки текста, новая строка каждый кадр
+static void log(Canvas &root, u32 frame) {
+    const Pixel row_height = 8;
+    const auto visible = static_cast<u32>(root.height() / row_height);
+    char line[24];
+
+    for (u32 i = 0; i < visible; ++i) {
+        const u32 entry = frame + i;
+        root.setCursor(0, static_cast<Pixel>(i * row_height));
+        std::snprintf(line, sizeof(line), "[%05u] ev %c%u", static_cast<unsigned>(entry * 37 % 100000), 'A' + static_cast<char>(entry % 26), static_cast<unsigned>(entry % 1000));
+        root.text(line);
+    }
+}
+
+/// Сетка значков с рамкой выбора
+static void icons(Canvas &root, u32 frame) {
+    const Pixel cell = 16;
+    const auto columns = static_cast<u32>(root.width() / cell);
+    const auto rows = static_cast<u32>(std::max(1, (root.height() - 8) / cell));
+    const u32 selected = frame % (columns * rows);
+    const BitMap<8, 8> *set[] = {&icon_battery, &icon_signal, &icon_gear, &icon_bell};
+
+    for (u32 i = 0; i < columns * rows; ++i) {
+        const auto x = static_cast<Pixel>(i % columns * cell);
+        const auto y = static_cast<Pixel>(i / columns * cell);
+        root.bitmap(static_cast<Pixel>(x + 4), static_cast<Pixel>(y + 4), *set[i % 4]);
+        if (i == selected) { root.rect(x, y, static_cast<Pixel>(x + cell - 1), static_cast<Pixel>(y + cell - 1), Canvas::Mode::FillBorder); }
+    }
+
+    char line[24];
+    root.setCursor(0, static_cast<Pixel>(root.height() - 8));
+    format(line, "App ", selected);
+    root.text(line);
+}
+
+struct Scenario {
+    const char *name;
+    void (*draw)(Canvas &, u32);
+};
+
+struct Display {
+    Pixel width, height;
+};
+
+int main(int argc, char **argv) {
+    const u32 frames = argc > 1 ? static_cast<u32>(std::strtoul(argv[1], nullptr, 10)) : 256;
+
+    const Scenario scenarios[] = {
+        {"dashboard", dashboard},
+        {"menu", menu},
+        {"chart", chart},
+        {"log", log},
+        {"icons", icons},
+    };
+    const Display displays[] = {{128, 32}, {128, 64}, {256, 128}};
+
+    std::printf("%-10s %8s %10s %10s %10s %6s\n", "scenario", "display", "frame us", "modified", "flush", "full");
+
+    for (const auto &display: displays) {
+        const Pixel pages = static_cast<Pixel>((display.height + 7) / 8);
+        const usize size = static_cast<usize>(display.width) * pages;
+
+        for (const auto &scenario: scenarios) {
+            std::vector<u8> buffer(size), previous(size);
+            Canvas root{FrameView{buffer.data(), display.width, display.width, display.height, 0, 0}, fonts::gyver_5x7_en};
+
+            // Время: минимум из прогонов всех кадров
+            double best = 1e30;
+            for (int repeat = 0; repeat < 5; ++repeat) {
+                const auto start = std::chrono::steady_clock::now();
+                for (u32 frame = 0; frame < frames; ++frame) {
+                    root.fill(false);
+                    scenario.draw(root, frame);
+                }
+                const auto end = std::chrono::steady_clock::now();
+                best = std::min(best, std::chrono::duration<double, std::micro>(end - start).count());
+            }
+
+            // Изменённые байты и частичная отправка между соседними кадрами
+            usize modified = 0, flush = 0;
+            for (u32 frame = 0; frame <= frames; ++frame) {
+                previous = buffer;
+                root.fill(false);
+                scenario.draw(root, frame);
+                if (frame == 0) { continue; }
+
+                for (Pixel page = 0; page < pages; ++page) {
+                    int first = -1, last = -1;
+                    for (Pixel x = 0; x < display.width; ++x) {
+                        const usize i = static_cast<usize>(page) * display.width + x;
+                        if (buffer[i] == previous[i]) { continue; }
+                        modified += 1;
+                        if (first < 0) { first = x; }
+                        last = x;
+                    }
+                    if (first >= 0) { flush += static_cast<usize>(last - first + 1); }
+                }
+            }
+
+            char resolution[16];
+            std::snprintf(resolution, sizeof(resolution), "%dx%d", display.width, display.height);
+            std::printf("%-10s %8s %10.2f %10.1f %10.1f %6zu\n",
+                        scenario.name, resolution, best / frames,
+                        static_cast<double>(modified) / frames, static_cast<double>(flush) / frames, size);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,673 @@
+// Преобразование изображений в исходники kf::gfx::BitMap
+//
+// Сборка:
+//   g++ -std=c++17 -O2 -I<KiraFlux-ToolBox>/src -Isrc tools/image_convert.cpp -o image_convert
+//
+// Использование:
+//   image_convert [-d none|bayer|fs|atkinson] [-t threshold] [-i] [-c] [-n namespace] [-o out.hpp] <image>...
+//
+//   -d  Размытие (по умолчанию none - порог)
+//   -t  Порог 0..255 для -d none (по умолчанию 127)
+//   -i  Включать светлые пиксели (по умолчанию включаются тёмные, как в PBM и ImageDecoder)
+//   -c  Обрезать изображение по включённым пикселям
+//   -n  Пространство имён результата (по умолчанию assets)
+//   -o  Файл результата (по умолчанию stdout)
+//
+// Форматы: PNG (без чересстрочности, 1-16 бит, любой тип цвета), PGM (P2, P5), PBM (P1, P4).
+// Прозрачные пиксели PNG накладываются на белый фон.
+// Одинаковые битмапы записываются один раз, остальные имена становятся ссылками на первый.
+// Итоговый объём данных во флеш-памяти выводится в stderr.
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <kf/gfx/Dither.hpp>
+#include <kf/gfx/FrameView.hpp>
+
+using namespace kf;
+using namespace kf::gfx;
+
+/// Полутоновое изображение, 0 - чёрный
+struct Gray {
+    int width{0};
+    int height{0};
+    std::vector<u8> pixels;
+};
+
+static bool readFile(const char *path, std::vector<u8> &data) {
+    std::FILE *file = std::fopen(path, "rb");
+    if (nullptr == file) { return false; }
+
+    u8 chunk[4096];
+    usize n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) { data.insert(data.end(), chunk, chunk + n); }
+
+    std::fclose(file);
+    return true;
+}
+
+// ---------------------------------------------------------------- Netpbm
+
+static int netpbmNumber(const std::vector<u8> &data, usize &pos) {
+    for (;;) {
+        while (pos < data.size() and std::strchr(" \t\r\n", data[pos]) != nullptr) { pos += 1; }
+        if (pos >= data.size() or data[pos] != '#') { break; }
+        while (pos < data.size() and data[pos] != '\n') { pos += 1; }
+    }
+
+    int value = -1;
+    while (pos < data.size() and data[pos] >= '0' and data[pos] <= '9') {
+        value = (value < 0 ? 0 : value * 10) + (data[pos] - '0');
+        pos += 1;
+    }
+    return value;
+}
+
+static bool loadNetpbm(const std::vector<u8> &data, Gray &image) {
+    if (data.size() < 3 or data[0] != 'P') { return false; }
+
+    const char kind = static_cast<char>(data[1]);
+    usize pos = 2;
+    image.width = netpbmNumber(data, pos);
+    image.height = netpbmNumber(data, pos);
+    const bool bitmap = kind == '1' or kind == '4';
+    const int max_value = bitmap ? 1 : netpbmNumber(data, pos);
+
+    if (image.width < 1 or image.height < 1 or max_value < 1) { return false; }
+    image.pixels.assign(static_cast<usize>(image.width) * image.height, 0);
+
+    const auto put = [&image, bitmap, max_value](usize index, int value) {
+        image.pixels[index] = bitmap ? (value ? 0 : 255) : static_cast<u8>(value * 255 / max_value);
+    };
+
+    if (kind == '1' or kind == '2') {
+        for (usize i = 0; i < image.pixels.size(); ++i) {
+            int value;
+            if (kind == '1') {
+                while (pos < data.size() and data[pos] != '0' and data[pos] != '1') { pos += 1; }
+                if (pos >= data.size()) { return false; }
+                value = data[pos++] - '0';
+            } else {
+                value = netpbmNumber(data, pos);
+                if (value < 0) { return false; }
+            }
+            put(i, value);
+        }
+        return true;
+    }
+
+    pos += 1;
+
+    if (kind == '4') {
+        const usize row_bytes = (image.width + 7) / 8;
+        if (pos + row_bytes * image.height > data.size()) { return false; }
+
+        for (int y = 0; y < image.height; ++y) {
+            for (int x = 0; x < image.width; ++x) {
+                put(static_cast<usize>(y) * image.width + x, (data[pos + y * row_bytes + x / 8] >> (7 - x % 8)) & 1);
+            }
+        }
+        return true;
+    }
+
+    if (kind == '5') {
+        const usize sample = max_value > 255 ? 2 : 1;
+        if (pos + image.pixels.size() * sample > data.size()) { return false; }
+
+        for (usize i = 0; i < image.pixels.size(); ++i) {
+            const int value = sample == 2 ? (data[pos + i * 2] << 8 | data[pos + i * 2 + 1]) : data[pos + i];
+            put(i, value);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+// ---------------------------------------------------------------- Inflate (RFC 1951)
+
+struct Inflate {
+    const u8 *data;
+    usize size;
+    usize pos{0};
+    u32 bit_buffer{0};
+    int bit_count{0};
+    std::vector<u8> out;
+
+    struct Huffman {
+        u16 count[16];
+        u16 symbol[320];
+    };
+
+    int bits(int need) {
+        u32 value = bit_buffer;
+        while (bit_count < need) {
+            if (pos >= size) { throw 0; }
+            value |= static_cast<u32>(data[pos++]) << bit_count;
+            bit_count += 8;
+        }
+        bit_buffer = value >> need;
+        bit_count -= need;
+        return static_cast<int>(value & ((1u << need) - 1));
+    }
+
+    static void build(Huffman &h, const u8 *lengths, int n) {
+        std::memset(h.count, 0, sizeof(h.count));
+        for (int i = 0; i < n; ++i) { h.count[lengths[i]] += 1; }
+
+        u16 offsets[16];
+        offsets[1] = 0;
+        for (int len = 1; len < 15; ++len) { offsets[len + 1] = offsets[len] + h.count[len]; }
+        for (int i = 0; i < n; ++i) {
+            if (lengths[i] != 0) { h.symbol[offsets[lengths[i]]++] = static_cast<u16>(i); }
+        }
+    }
+
+    int decode(const Huffman &h) {
+        int code = 0;
+        int first = 0;
+        int index = 0;
+
+        for (int len = 1; len < 16; ++len) {
+            code |= bits(1);
+            const int count = h.count[len];
+            if (code - count < first) { return h.symbol[index + (code - first)]; }
+            index += count;
+            first += count;
+            first <<= 1;
+            code <<= 1;
+        }
+        throw 0;
+    }
+
+    void codes(const Huffman &lengths, const Huffman &distances) {
+        static constexpr u16 length_base[] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static constexpr u8 length_extra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        static constexpr u16 distance_base[] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+        static constexpr u8 distance_extra[] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+        for (;;) {
+            int symbol = decode(lengths);
+            if (symbol < 256) {
+                out.push_back(static_cast<u8>(symbol));
+                continue;
+            }
+            if (symbol == 256) { return; }
+
+            symbol -= 257;
+            if (symbol >= 29) { throw 0; }
+            const int length = length_base[symbol] + bits(length_extra[symbol]);
+
+            const int distance_symbol = decode(distances);
+            if (distance_symbol >= 30) { throw 0; }
+            const usize distance = distance_base[distance_symbol] + bits(distance_extra[distance_symbol]);
+            if (distance > out.size()) { throw 0; }
+
+            for (int i = 0; i < length; ++i) { out.push_back(out[out.size() - distance]); }
+        }
+    }
+
+    void run() {
+        int last;
+        do {
+            last = bits(1);
+            const int type = bits(2);
+
+            if (type == 0) {
+                bit_buffer = 0;
+                bit_count = 0;
+                if (pos + 4 > size) { throw 0; }
+                const usize length = data[pos] | data[pos + 1] << 8;
+                pos += 4;
+                if (pos + length > size) { throw 0; }
+                out.insert(out.end(), data + pos, data + pos + length);
+                pos += length;
+            } else if (type == 1) {
+                u8 lengths[320];
+                int i = 0;
+                for (; i < 144; ++i) { lengths[i] = 8; }
+                for (; i < 256; ++i) { lengths[i] = 9; }
+                for (; i < 280; ++i) { lengths[i] = 7; }
+                for (; i < 288; ++i) { lengths[i] = 8; }
+                Huffman literal;
+                build(literal, lengths, 288);
+                for (i = 0; i < 30; ++i) { lengths[i] = 5; }
+                Huffman distance;
+                build(distance, lengths, 30);
+                codes(literal, distance);
+            } else if (type == 2) {
+                static constexpr u8 order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+                const int literal_count = bits(5) + 257;
+                const int distance_count = bits(5) + 1;
+                const int code_count = bits(4) + 4;
+
+                u8 lengths[320] = {};
+                for (int i = 0; i < code_count; ++i) { lengths[order[i]] = static_cast<u8>(bits(3)); }
+                Huffman code_lengths;
+                build(code_lengths, lengths, 19);
+
+                int index = 0;
+                while (index < literal_count + distance_count) {
+                    int symbol = decode(code_lengths);
+                    if (symbol < 16) {
+                        lengths[index++] = static_cast<u8>(symbol);
+                        continue;
+                    }
+
+                    u8 value = 0;
+                    int repeat;
+                    if (symbol == 16) {
+                        if (index == 0) { throw 0; }
+                        value = lengths[index - 1];
+                        repeat = 3 + bits(2);
+                    } else if (symbol == 17) {
+                        repeat = 3 + bits(3);
+                    } else {
+                        repeat = 11 + bits(7);
+                    }
+                    if (index + repeat > literal_count + distance_count) { throw 0; }
+                    while (repeat-- > 0) { lengths[index++] = value; }
+                }
+
+                Huffman literal;
+                Huffman distance;
+                build(literal, lengths, literal_count);
+                build(distance, lengths + literal_count, distance_count);
+                codes(literal, distance);
+            } else {
+                throw 0;
+            }
+        } while (not last);
+    }
+};
+
+// ---------------------------------------------------------------- PNG
+
+static u32 readBe(const u8 *p) { return static_cast<u32>(p[0]) << 24 | p[1] << 16 | p[2] << 8 | p[3]; }
+
+static bool loadPng(const std::vector<u8> &data, Gray &image) {
+    static constexpr u8 signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (data.size() < 8 or std::memcmp(data.data(), signature, 8) != 0) { return false; }
+
+    int depth = 0;
+    int color_type = 0;
+    std::vector<u8> compressed;
+    u8 palette[256][4];
+    std::memset(palette, 0xFF, sizeof(palette));
+
+    for (usize pos = 8; pos + 12 <= data.size();) {
+        const u32 length = readBe(data.data() + pos);
+        const u8 *type = data.data() + pos + 4;
+        const u8 *chunk = data.data() + pos + 8;
+        if (pos + 12 + length > data.size()) { return false; }
+
+        if (std::memcmp(type, "IHDR", 4) == 0) {
+            if (length != 13) {
+                std::fprintf(stderr, "bad PNG header length %u\n", static_cast<unsigned>(length));
+                return false;
+            }
+
+            image.width = static_cast<int>(readBe(chunk));
+            image.height = static_cast<int>(readBe(chunk + 4));
+            depth = chunk[8];
+            color_type = chunk[9];
+            if (chunk[12] != 0) {
+                std::fprintf(stderr, "interlaced PNG is not supported\n");
+                return false;
+            }
+        } else if (std::memcmp(type, "PLTE", 4) == 0) {
+            for (u32 i = 0; i < length / 3 and i < 256; ++i) { std::memcpy(palette[i], chunk + i * 3, 3); }
+        } else if (std::memcmp(type, "tRNS", 4) == 0 and color_type == 3) {
+            for (u32 i = 0; i < length and i < 256; ++i) { palette[i][3] = chunk[i]; }
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            compressed.insert(compressed.end(), chunk, chunk + length);
+        } else if (std::memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+
+        pos += 12 + length;
+    }
+
+    if (image.width < 1 or image.height < 1 or compressed.size() < 2) { return false; }
+
+    static constexpr int channels_of[7] = {1, 0, 3, 1, 2, 0, 4};
+    if (color_type > 6 or channels_of[color_type] == 0) { return false; }
+    const int channels = channels_of[color_type];
+
+    // Допустимые сочетания глубины и типа цвета: 1/2/4/8/16 для серого, 1/2/4/8 для палитры, 8/16 для остальных
+    const bool low_depth = depth == 1 or depth == 2 or depth == 4;
+    const bool valid_depth = (depth == 8) or
+                             (depth == 16 and color_type != 3) or
+                             (low_depth and (color_type == 0 or color_type == 3));
+    if (not valid_depth) {
+        std::fprintf(stderr, "bad PNG bit depth %d for color type %d\n", depth, color_type);
+        return false;
+    }
+
+    // Размер строки, распакованных данных и изображения без переполнения usize
+    const usize max_size = std::numeric_limits<usize>::max();
+    const usize row_bits = static_cast<usize>(channels) * depth;
+    const auto width = static_cast<usize>(image.width);
+    const auto height = static_cast<usize>(image.height);
+    if (width > (max_size - 7) / row_bits or height > max_size / ((width * row_bits + 7) / 8 + 1) or width > max_size / height) {
+        std::fprintf(stderr, "PNG size %dx%d is too large\n", image.width, image.height);
+        return false;
+    }
+
+    // Поток zlib: 2 байта заголовка, затем deflate
+    Inflate inflate{compressed.data() + 2, compressed.size() - 2, 0, 0, 0, {}};
+    try {
+        inflate.run();
+    } catch (int) {
+        return false;
+    }
+
+    const usize pixel_bits = static_cast<usize>(channels) * depth;
+    const usize stride = (image.width * pixel_bits + 7) / 8;
+    const usize bpp = std::max<usize>(1, pixel_bits / 8);
+    std::vector<u8> &raw = inflate.out;
+    if (raw.size() < (stride + 1) * image.height) { return false; }
+
+    // Снятие фильтров строк
+    std::vector<u8> previous(stride, 0);
+    std::vector<u8> rows(stride * image.height);
+
+    for (int y = 0; y < image.height; ++y) {
+        const u8 filter = raw[y * (stride + 1)];
+        const u8 *line = raw.data() + y * (stride + 1) + 1;
+        u8 *row = rows.data() + y * stride;
+
+        for (usize i = 0; i < stride; ++i) {
+            const int a = i >= bpp ? row[i - bpp] : 0;
+            const int b = previous[i];
+            const int c = i >= bpp ? previous[i - bpp] : 0;
+            int predictor = 0;
+
+            switch (filter) {
+                case 0: predictor = 0; break;
+                case 1: predictor = a; break;
+                case 2: predictor = b; break;
+                case 3: predictor = (a + b) / 2; break;
+                case 4: {
+                    const int p = a + b - c;
+                    const int pa = std::abs(p - a);
+                    const int pb = std::abs(p - b);
+                    const int pc = std::abs(p - c);
+                    predictor = (pa <= pb and pa <= pc) ? a : (pb <= pc ? b : c);
+                } break;
+                default: return false;
+            }
+
+            row[i] = static_cast<u8>(line[i] + predictor);
+        }
+
+        std::memcpy(previous.data(), row, stride);
+    }
+
+    // Выборка: значение канала ch пикселя x, приведённое к 0..255
+    const int max_sample = (1 << std::min(depth, 8)) - 1;
+    const auto sample = [&](const u8 *row, int x, int ch) -> int {
+        const usize index = static_cast<usize>(x) * channels + ch;
+        if (depth == 16) { return row[index * 2]; }
+        if (depth == 8) { return row[index]; }
+
+        const usize bit = index * depth;
+        return (row[bit / 8] >> (8 - depth - bit % 8)) & max_sample;
+    };
+
+    image.pixels.resize(static_cast<usize>(image.width) * image.height);
+
+    for (int y = 0; y < image.height; ++y) {
+        const u8 *row = rows.data() + y * stride;
+
+        for (int x = 0; x < image.width; ++x) {
+            int r, g, b, alpha = 255;
+
+            if (color_type == 3) {
+                const u8 *entry = palette[sample(row, x, 0)];
+                r = entry[0];
+                g = entry[1];
+                b = entry[2];
+                alpha = entry[3];
+            } else {
+                const int scale = depth >= 8 ? 1 : 255 / max_sample;
+                r = sample(row, x, 0) * scale;
+                g = channels >= 3 ? sample(row, x, 1) : r;
+                b = channels >= 3 ? sample(row, x, 2) : r;
+                if (color_type == 4) { alpha = sample(row, x, 1); }
+                if (color_type == 6) { alpha = sample(row, x, 3); }
+            }
+
+            // Наложение на белый фон
+            const int luminance = (r * 3 + g * 6 + b) / 10;
+            image.pixels[static_cast<usize>(y) * image.width + x] = static_cast<u8>((luminance * alpha + 255 * (255 - alpha)) / 255);
+        }
+    }
+
+    return true;
+}
+
+// ---------------------------------------------------------------- Преобразование
+
+enum class Dither { None, Bayer, FloydSteinberg, Atkinson };
+
+/// Битмап в страничном формате
+struct Bitmap {
+    int width{0};
+    int height{0};
+    std::vector<u8> pages;
+};
+
+static constexpr Pixel max_width = 1024;
+
+static Bitmap convert(const Gray &source, Dither method, u8 threshold, bool light_on) {
+    // Для dither включаются пиксели ярче порога
+    Gray image = source;
+    if (not light_on) {
+        for (u8 &p: image.pixels) { p = static_cast<u8>(255 - p); }
+        threshold = static_cast<u8>(255 - threshold);
+    }
+
+    Bitmap bitmap;
+    bitmap.width = image.width;
+    bitmap.height = image.height;
+    bitmap.pages.assign(static_cast<usize>(image.width) * ((image.height + 7) / 8), 0);
+
+    const FrameView target{bitmap.pages.data(), static_cast<Pixel>(image.width), static_cast<Pixel>(image.width), static_cast<Pixel>(image.height), 0, 0};
+    const dither::GrayImage gray{image.pixels.data(), static_cast<Pixel>(image.width), static_cast<Pixel>(image.height), static_cast<usize>(image.width)};
+
+    static dither::ErrorDiffusion<max_width> diffusion;
+
+    switch (method) {
+        case Dither::None: dither::threshold(target, 0, 0, gray, threshold); break;
+        case Dither::Bayer: dither::ordered(target, 0, 0, gray); break;
+        case Dither::FloydSteinberg: diffusion.floydSteinberg(target, 0, 0, gray); break;
+        case Dither::Atkinson: diffusion.atkinson(target, 0, 0, gray); break;
+    }
+
+    return bitmap;
+}
+
+static bool pixelAt(const Bitmap &bitmap, int x, int y) {
+    return (bitmap.pages[static_cast<usize>(y / 8) * bitmap.width + x] >> (y % 8)) & 1;
+}
+
+/// Обрезка по включённым пикселям (пустое изображение - 1x1)
+static Bitmap crop(const Bitmap &bitmap) {
+    int left = bitmap.width, top = bitmap.height, right = -1, bottom = -1;
+
+    for (int y = 0; y < bitmap.height; ++y) {
+        for (int x = 0; x < bitmap.width; ++x) {
+            if (not pixelAt(bitmap, x, y)) { continue; }
+            left = std::min(left, x);
+            right = std::max(right, x);
+            top = std::min(top, y);
+            bottom = std::max(bottom, y);
+        }
+    }
+
+    Bitmap result;
+    if (right < 0) {
+        result.width = 1;
+        result.height = 1;
+        result.pages.assign(1, 0);
+        return result;
+    }
+
+    result.width = right - left + 1;
+    result.height = bottom - top + 1;
+    result.pages.assign(static_cast<usize>(result.width) * ((result.height + 7) / 8), 0);
+
+    for (int y = 0; y < result.height; ++y) {
+        for (int x = 0; x < result.width; ++x) {
+            if (pixelAt(bitmap, left + x, top + y)) { result.pages[static_cast<usize>(y / 8) * result.width + x] |= 1 << (y % 8); }
+        }
+    }
+
+    return result;
+}
+
+/// Имя C++ из имени файла
+static std::string identifier(const char *path) {
+    std::string name = path;
+    const usize slash = name.find_last_of("/\\");
+    if (slash != std::string::npos) { name = name.substr(slash + 1); }
+    const usize dot = name.find_last_of('.');
+    if (dot != std::string::npos and dot > 0) { name = name.substr(0, dot); }
+
+    for (char &c: name) {
+        if (not std::isalnum(static_cast<unsigned char>(c))) { c = '_'; }
+    }
+    if (name.empty() or std::isdigit(static_cast<unsigned char>(name[0]))) { name.insert(0, "image_"); }
+    return name;
+}
+
+int main(int argc, char **argv) {
+    Dither method = Dither::None;
+    int threshold = 127;
+    bool light_on = false;
+    bool crop_content = false;
+    std::string name_space = "assets";
+    const char *output_path = nullptr;
+    int arg = 1;
+
+    for (; arg < argc and argv[arg][0] == '-'; ++arg) {
+        const std::string option = argv[arg];
+        const bool has_value = arg + 1 < argc;
+
+        if (option == "-i") {
+            light_on = true;
+        } else if (option == "-c") {
+            crop_content = true;
+        } else if (option == "-d" and has_value) {
+            const std::string value = argv[++arg];
+            if (value == "none") {
+                method = Dither::None;
+            } else if (value == "bayer") {
+                method = Dither::Bayer;
+            } else if (value == "fs") {
+                method = Dither::FloydSteinberg;
+            } else if (value == "atkinson") {
+                method = Dither::Atkinson;
+            } else {
+                std::fprintf(stderr, "unknown dither: %s\n", value.c_str());
+                return 2;
+            }
+        } else if (option == "-t" and has_value) {
+            threshold = std::atoi(argv[++arg]);
+        } else if (option == "-n" and has_value) {
+            name_space = argv[++arg];
+        } else if (option == "-o" and has_value) {
+            output_path = argv[++arg];
+        } else {
+            break;
+        }
+    }
+
+    if (arg >= argc or threshold < 0 or threshold > 255) {
+        std::fprintf(stderr, "usage: %s [-d none|bayer|fs|atkinson] [-t threshold] [-i] [-c] [-n namespace] [-o out.hpp] <image>...\n", argv[0]);
+        return 2;
+    }
+
+    std::string out = "#pragma once\n\n#include <kf/gfx/BitMap.hpp>\n\n";
+    out += "// Сгенерировано tools/image_convert.cpp\n";
+    out += "namespace " + name_space + " {\n";
+
+    std::map<std::string, std::string> unique;// данные -> имя первого битмапа
+    std::map<std::string, int> used_names;
+    usize flash_bytes = 0;
+    usize duplicates = 0;
+
+    for (; arg < argc; ++arg) {
+        const char *path = argv[arg];
+        std::vector<u8> data;
+        Gray image;
+
+        if (not readFile(path, data)) {
+            std::perror(path);
+            return 1;
+        }
+
+        if (not loadPng(data, image) and not loadNetpbm(data, image)) {
+            std::fprintf(stderr, "%s: unsupported or corrupted image\n", path);
+            return 1;
+        }
+
+        if (image.width > max_width or image.height > 0x7FFF) {
+            std::fprintf(stderr, "%s: image too large\n", path);
+            return 1;
+        }
+
+        Bitmap bitmap = convert(image, method, static_cast<u8>(threshold), light_on);
+        if (crop_content) { bitmap = crop(bitmap); }
+
+        std::string name = identifier(path);
+        const int suffix = used_names[name]++;
+        if (suffix > 0) { name += "_" + std::to_string(suffix); }
+
+        const std::string type = "kf::gfx::BitMap<" + std::to_string(bitmap.width) + ", " + std::to_string(bitmap.height) + ">";
+        const std::string key = type + std::string(bitmap.pages.begin(), bitmap.pages.end());
+
+        const auto found = unique.find(key);
+        if (found != unique.end()) {
+            out += "\n/// " + std::string(path) + " (совпадает с " + found->second + ")\n";
+            out += "static constexpr const " + type + " &" + name + " = " + found->second + ";\n";
+            duplicates += 1;
+            continue;
+        }
+
+        unique.emplace(key, name);
+        flash_bytes += bitmap.pages.size();
+
+        out += "\n/// " + std::string(path) + "\n";
+        out += "static constexpr " + type + " " + name + " = {";
+
+        for (usize i = 0; i < bitmap.pages.size(); ++i) {
+            char hex[8];
+            std::snprintf(hex, sizeof(hex), "0x%02X", bitmap.pages[i]);
+            out += (i % 16 == 0) ? "\n    " : " ";
+            out += hex;
+            out += ",";
+        }
+        out += "\n};\n";
+    }
+
+    out += "\n}// namespace " + name_space + "\n";
+
+    std::FILE *file = output_path != nullptr ? std::fopen(output_path, "wb") : stdout;
+    if (nullptr == file or std::fwrite(out.data(), 1, out.size(), file) != out.size()) {
+        std::perror(output_path != nullptr ? output_path : "stdout");
+        return 2;
+    }
+    if (file != stdout) { std::fclose(file); }
+
+    std::fprintf(stderr, "%zu bitmaps (%zu duplicates), flash %zu bytes\n", unique.size() + duplicates, duplicates, flash_bytes);
+    return 0;
+}
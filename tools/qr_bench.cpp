@@ -0,0 +1,154 @@
+// Замер kf::gfx::QrCode: время кодирования и отрисовки, глубина стека
+//
+// Сборка:
+//   g++ -std=c++17 -O2 -I<KiraFlux-ToolBox>/src -Isrc tools/qr_bench.cpp src/kf/gfx/Font.cpp -o qr_bench
+//
+// Использование:
+//   qr_bench [repeats]
+//
+// Для данных разной длины и каждого уровня коррекции выводятся:
+//   encode us - encode() с автоматическим выбором маски
+//   render us - render() с модулем 2x2 и свободной зоной
+//   rect us   - отрисовка тех же модулей через Canvas::rect (заливка области и rect на каждый тёмный модуль)
+//   stack     - глубина стека encode() и render() в байтах (по закраске отдельного стека, вместе с кадром обёртки)
+// Кадр render() сверяется с отрисовкой через rect. Код возврата 1 при расхождении.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <ucontext.h>
+
+#include <kf/gfx.hpp>
+
+using namespace kf;
+using namespace kf::gfx;
+
+static constexpr u8 scale = 2;
+
+/// Область с запасом под версию 10 с модулем 2x2
+static constexpr Pixel side = 136;
+static constexpr usize frame_size = side * side / 8;
+
+/// Отдельный стек для замера глубины: закрашивается и после вызова просматривается с нижнего края
+static constexpr usize stack_size = 64 * 1024;
+static constexpr u8 paint_value = 0xCD;
+alignas(16) static u8 stack[stack_size];
+
+static ucontext_t main_context, bench_context;
+
+/// Аргументы вызова на отдельном стеке
+static struct {
+    QrCode *qr;
+    const char *text;
+    QrCode::Ecc ecc;
+    const FrameView *frame;
+} call;
+
+static void encodeAndRender() {
+    if (call.qr->encode(call.text, call.ecc).isOk()) { call.qr->render(*call.frame, 0, 0, scale); }
+}
+
+/// Глубина стека encode() и render()
+static usize measureStack(QrCode &qr, const char *text, QrCode::Ecc ecc, const FrameView &frame) {
+    call = {&qr, text, ecc, &frame};
+    std::memset(stack, paint_value, sizeof(stack));
+
+    getcontext(&bench_context);
+    bench_context.uc_stack.ss_sp = stack;
+    bench_context.uc_stack.ss_size = sizeof(stack);
+    bench_context.uc_link = &main_context;
+    makecontext(&bench_context, encodeAndRender, 0);
+    swapcontext(&main_context, &bench_context);
+
+    usize untouched = 0;
+    while (untouched < stack_size and stack[untouched] == paint_value) { untouched += 1; }
+    return stack_size - untouched;
+}
+
+/// Отрисовка через rect: светлая область и тёмные модули
+static void renderRects(const QrCode &qr, const FrameView &frame) {
+    Canvas canvas{frame};
+    const Pixel pixels = qr.pixelSize(scale);
+    canvas.rect(0, 0, static_cast<Pixel>(pixels - 1), static_cast<Pixel>(pixels - 1), Canvas::Mode::Fill);
+
+    for (Pixel y = 0; y < qr.size(); ++y) {
+        for (Pixel x = 0; x < qr.size(); ++x) {
+            if (not qr.module(x, y)) { continue; }
+
+            const auto px = static_cast<Pixel>((x + QrCode::quiet_zone) * scale);
+            const auto py = static_cast<Pixel>((y + QrCode::quiet_zone) * scale);
+            canvas.rect(px, py, static_cast<Pixel>(px + scale - 1), static_cast<Pixel>(py + scale - 1), Canvas::Mode::Clear);
+        }
+    }
+}
+
+template<typename F> static double measure(int repeats, F run) {
+    double best = 1e30;
+    for (int repeat = 0; repeat < 5; ++repeat) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeats; ++i) { run(); }
+        const auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    return best / repeats;
+}
+
+int main(int argc, char **argv) {
+    const int repeats = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    // Ссылка, строка Wi-Fi, данные средней и предельной для версии 10 длины
+    std::vector<std::string> payloads = {
+        "https://kiraflux.dev/p/1234",
+        "WIFI:S:kira-lab;T:WPA;P:correct horse battery staple;;",
+        std::string(96, 'x'),
+        std::string(213, 'y'),
+    };
+
+    const QrCode::Ecc levels[] = {QrCode::Ecc::Low, QrCode::Ecc::Medium, QrCode::Ecc::High};
+    const char *level_names[] = {"L", "M", "H"};
+
+    std::printf("sizeof(QrCode) = %zu bytes, module %ux%u\n\n", sizeof(QrCode), scale, scale);
+    std::printf("%6s %4s %8s %10s %10s %10s %7s\n", "bytes", "ecc", "version", "encode us", "render us", "rect us", "stack");
+
+    static QrCode qr;
+    std::vector<u8> buffer(frame_size), reference(frame_size);
+    const FrameView frame{buffer.data(), side, side, side, 0, 0};
+    const FrameView reference_frame{reference.data(), side, side, side, 0, 0};
+
+    usize mismatches = 0;
+
+    for (const auto &payload: payloads) {
+        for (u8 level = 0; level < 3; ++level) {
+            const QrCode::Ecc ecc = levels[level];
+            const char *text = payload.c_str();
+
+            if (not qr.encode(text, ecc).isOk()) {
+                std::printf("%6zu %4s %8s\n", payload.size(), level_names[level], "-");
+                continue;
+            }
+
+            const usize stack_used = measureStack(qr, text, ecc, frame);
+
+            std::fill(buffer.begin(), buffer.end(), 0);
+            std::fill(reference.begin(), reference.end(), 0);
+            qr.render(frame, 0, 0, scale);
+            renderRects(qr, reference_frame);
+            if (buffer != reference) { mismatches += 1; }
+
+            const double encode_us = measure(repeats, [&] { (void) qr.encode(text, ecc); });
+            const double render_us = measure(repeats, [&] { qr.render(frame, 0, 0, scale); });
+            const double rect_us = measure(repeats, [&] { renderRects(qr, reference_frame); });
+
+            std::printf("%6zu %4s %8u %10.2f %10.2f %10.2f %7zu\n",
+                        payload.size(), level_names[level], qr.version(), encode_us, render_us, rect_us, stack_used);
+        }
+    }
+
+    std::printf("\n%zu render mismatches\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
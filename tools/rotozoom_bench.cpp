@@ -0,0 +1,184 @@
+// Проверка и замер kf::gfx::rotozoom::draw против попиксельного эталона на getPixel / setPixel
+//
+// Сборка:
+//   g++ -std=c++17 -O2 -I<KiraFlux-ToolBox>/src -Isrc tools/rotozoom_bench.cpp -o rotozoom_bench
+//
+// Использование:
+//   rotozoom_bench [iterations] [seed]
+//
+// Эталон проходит прямоугольник вывода попиксельно, для каждого пикселя вычисляет точку битмапа
+// тем же отображением Q16 и копирует её через getPixel / setPixel. Проверка: случайные битмапы,
+// углы, масштабы, центры (в том числе за границами) и дочерние области со смещением,
+// прозрачный и непрозрачный вывод; буферы должны совпасть побайтово. Замер: битмапы 16x16,
+// 32x32 и 64x64 на дисплее 128x64 при масштабах 0.5, 1 и 2. Код возврата 1 при расхождении.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <kf/gfx/FrameView.hpp>
+#include <kf/gfx/Rotozoom.hpp>
+
+using namespace kf;
+using namespace kf::gfx;
+
+/// Битмап с буфером и видом для getPixel
+struct Image {
+    Pixel width, height;
+    std::vector<u8> buffer;
+
+    Image(Pixel width, Pixel height, std::mt19937 &rng) :
+        width{width}, height{height}, buffer(static_cast<usize>(width) * ((height + 7) / 8)) {
+        for (auto &b: buffer) { b = static_cast<u8>(rng()); }
+    }
+
+    [[nodiscard]] BitMapView view() const { return {buffer.data(), width, height}; }
+
+    [[nodiscard]] FrameView frame() { return FrameView{buffer.data(), width, width, height, 0, 0}; }
+};
+
+struct Case {
+    Pixel center_x, center_y;
+    trig::Angle angle;
+    u16 zoom;
+    bool on, opaque;
+};
+
+/// Эталон: обратное отображение для каждого пикселя прямоугольника вывода
+static void drawReference(const FrameView &target, Image &image, const Case &c) {
+    collision::Box box = rotozoom::bounds(image.view(), c.center_x, c.center_y, c.angle, c.zoom);
+    box.left = std::max(box.left, static_cast<Pixel>(0));
+    box.top = std::max(box.top, static_cast<Pixel>(0));
+    box.right = std::min(box.right, target.width);
+    box.bottom = std::min(box.bottom, target.height);
+
+    const i32 cosine = trig::cos(c.angle) * (1 << 10) / c.zoom;
+    const i32 sine = trig::sin(c.angle) * (1 << 10) / c.zoom;
+    const FrameView source = image.frame();
+
+    for (Pixel y = box.top; y < box.bottom; ++y) {
+        for (Pixel x = box.left; x < box.right; ++x) {
+            const i32 dx = x - c.center_x;
+            const i32 dy = y - c.center_y;
+            const i32 u = image.width / 2 * (1 << rotozoom::fraction_bits) + dx * cosine + dy * sine;
+            const i32 v = image.height / 2 * (1 << rotozoom::fraction_bits) - dx * sine + dy * cosine;
+            if (u < 0 or v < 0 or u >= image.width * (1 << rotozoom::fraction_bits) or v >= image.height * (1 << rotozoom::fraction_bits)) { continue; }
+
+            const bool bit = source.getPixel(static_cast<Pixel>(u >> rotozoom::fraction_bits), static_cast<Pixel>(v >> rotozoom::fraction_bits));
+            if (bit) {
+                target.setPixel(x, y, c.on);
+            } else if (c.opaque) {
+                target.setPixel(x, y, not c.on);
+            }
+        }
+    }
+}
+
+static Case randomCase(std::mt19937 &rng, const FrameView &target) {
+    Case c{};
+    c.center_x = static_cast<Pixel>(static_cast<int>(rng() % (target.width + 60)) - 30);
+    c.center_y = static_cast<Pixel>(static_cast<int>(rng() % (target.height + 60)) - 30);
+    c.angle = static_cast<trig::Angle>(rng());
+    c.zoom = static_cast<u16>(32 + rng() % 1024);
+    c.on = rng() & 1;
+    c.opaque = rng() & 1;
+    return c;
+}
+
+/// Случайная проверка
+/// @returns Количество расхождений
+static usize check(std::mt19937 &rng, usize iterations) {
+    usize mismatches = 0;
+
+    for (usize i = 0; i < iterations; ++i) {
+        const auto display_width = static_cast<Pixel>(1 + rng() % 160);
+        const auto display_height = static_cast<Pixel>(1 + rng() % 72);
+        const usize size = static_cast<usize>(display_width) * ((display_height + 7) / 8);
+
+        std::vector<u8> fast(size);
+        for (auto &b: fast) { b = static_cast<u8>(rng()); }
+        std::vector<u8> reference = fast;
+
+        const auto sub_x = static_cast<Pixel>(rng() % display_width);
+        const auto sub_y = static_cast<Pixel>(rng() % display_height);
+        const auto sub_width = static_cast<Pixel>(1 + rng() % (display_width - sub_x));
+        const auto sub_height = static_cast<Pixel>(1 + rng() % (display_height - sub_y));
+
+        const FrameView fast_frame{fast.data(), display_width, sub_width, sub_height, sub_x, sub_y};
+        const FrameView reference_frame{reference.data(), display_width, sub_width, sub_height, sub_x, sub_y};
+
+        Image image{static_cast<Pixel>(1 + rng() % 48), static_cast<Pixel>(1 + rng() % 48), rng};
+        const Case c = randomCase(rng, fast_frame);
+
+        rotozoom::draw(fast_frame, image.view(), c.center_x, c.center_y, c.angle, c.zoom, c.on, c.opaque);
+        drawReference(reference_frame, image, c);
+
+        if (fast != reference) {
+            mismatches += 1;
+            std::printf(
+                "mismatch: display %dx%d view %dx%d+%d+%d bitmap %dx%d center %d %d angle %u zoom %u on %d opaque %d\n",
+                display_width, display_height, sub_width, sub_height, sub_x, sub_y, image.width, image.height,
+                c.center_x, c.center_y, c.angle, c.zoom, c.on, c.opaque);
+        }
+    }
+
+    return mismatches;
+}
+
+/// Время вывода, мкс (минимум из нескольких повторов)
+template<typename F> static double measure(usize count, F draw) {
+    double best = 1e30;
+
+    for (int repeat = 0; repeat < 5; ++repeat) {
+        const auto start = std::chrono::steady_clock::now();
+        for (usize i = 0; i < count; ++i) { draw(i); }
+        const auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::micro>(end - start).count());
+    }
+
+    return best / static_cast<double>(count);
+}
+
+int main(int argc, char **argv) {
+    const usize iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const auto seed = static_cast<u32>(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1);
+
+    std::mt19937 rng{seed};
+    const usize mismatches = check(rng, iterations);
+    std::printf("%zu cases, seed %u, %zu mismatches\n\n", iterations, seed, mismatches);
+
+    // Замер на полном дисплее 128x64, центр в середине, случайные углы
+    std::vector<u8> buffer(128 * 8);
+    const FrameView frame{buffer.data(), 128, 128, 64, 0, 0};
+
+    const Pixel sizes[] = {16, 32, 64};
+    const u16 zooms[] = {128, 256, 512};
+    const usize count = 1024;
+
+    std::printf("%-8s %6s %10s %12s %9s\n", "bitmap", "zoom", "draw us", "per-pixel us", "speedup");
+
+    for (const Pixel side: sizes) {
+        Image image{side, side, rng};
+
+        for (const u16 zoom: zooms) {
+            std::vector<Case> cases(count);
+            for (auto &c: cases) { c = Case{64, 32, static_cast<trig::Angle>(rng()), zoom, true, true}; }
+
+            const double fast_us = measure(count, [&](usize i) {
+                const Case &c = cases[i];
+                rotozoom::draw(frame, image.view(), c.center_x, c.center_y, c.angle, c.zoom, c.on, c.opaque);
+            });
+            const double reference_us = measure(count, [&](usize i) { drawReference(frame, image, cases[i]); });
+
+            char name[16];
+            std::snprintf(name, sizeof(name), "%dx%d", side, side);
+            std::printf("%-8s %6.2f %10.2f %12.2f %8.1fx\n",
+                        name, zoom / 256.0, fast_us, reference_us, reference_us / fast_us);
+        }
+    }
+
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+// Восстановление кадров из выгрузки kf::gfx::SnapshotRecorder
+//
+// Сборка:
+//   g++ -std=c++17 -O2 -I<KiraFlux-ToolBox>/src -Isrc tools/snapshot_decode.cpp -o snapshot_decode
+//
+// Использование:
+//   snapshot_decode <dump.bin> [prefix]
+//
+// Кадры записываются как <prefix>NNN.pbm от старого к новому (по умолчанию prefix = "frame_").
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <kf/gfx/SnapshotRecorder.hpp>
+
+using namespace kf;
+using namespace kf::gfx;
+
+static const char *errorName(SnapshotReader::Error error) {
+    switch (error) {
+        case SnapshotReader::Error::BadHeader: return "bad header";
+        case SnapshotReader::Error::UnsupportedVersion: return "unsupported version";
+        case SnapshotReader::Error::Truncated: return "truncated";
+        case SnapshotReader::Error::Corrupted: return "corrupted delta";
+    }
+    return "?";
+}
+
+static bool writePbm(const std::string &path, const u8 *frame, Pixel width, Pixel height) {
+    std::FILE *out = std::fopen(path.c_str(), "wb");
+    if (nullptr == out) { return false; }
+
+    std::fprintf(out, "P1\n%d %d\n", width, height);
+    for (Pixel y = 0; y < height; ++y) {
+        for (Pixel x = 0; x < width; ++x) {
+            const bool on = frame[(y >> 3) * width + x] & (1 << (y & 7));
+            std::fputc(on ? '1' : '0', out);
+        }
+        std::fputc('\n', out);
+    }
+
+    std::fclose(out);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <dump.bin> [prefix]\n", argv[0]);
+        return 2;
+    }
+
+    const std::string prefix = argc > 2 ? argv[2] : "frame_";
+
+    std::FILE *file = std::fopen(argv[1], "rb");
+    if (nullptr == file) {
+        std::perror(argv[1]);
+        return 2;
+    }
+
+    std::vector<u8> dump;
+    for (int c; (c = std::fgetc(file)) != EOF;) { dump.push_back(static_cast<u8>(c)); }
+    std::fclose(file);
+
+    const auto reader_result = SnapshotReader::create(dump.data(), dump.size());
+    if (not reader_result.isOk()) {
+        std::fprintf(stderr, "%s: %s\n", argv[1], errorName(reader_result.error().value()));
+        return 1;
+    }
+
+    const auto reader = reader_result.ok().value();
+    std::vector<u8> frames(reader.frames * reader.frameSize());
+
+    const auto decode_result = reader.decode(frames.data());
+    if (not decode_result.isOk()) {
+        std::fprintf(stderr, "%s: %s\n", argv[1], errorName(decode_result.error().value()));
+        return 1;
+    }
+
+    for (u16 i = 0; i < reader.frames; ++i) {
+        char index[16];
+        std::snprintf(index, sizeof(index), "%03u.pbm", i);
+
+        const std::string path = prefix + index;
+        if (not writePbm(path, frames.data() + i * reader.frameSize(), reader.width, reader.height)) {
+            std::perror(path.c_str());
+            return 2;
+        }
+    }
+
+    std::printf("%dx%d, %u frames, %zu bytes\n", reader.width, reader.height, reader.frames, dump.size());
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Точность и скорость kf::gfx::trig против libm
+//
+// Сборка:
+//   g++ -std=c++17 -O2 -I<KiraFlux-ToolBox>/src -Isrc tools/trig_bench.cpp -o trig_bench
+//
+// Использование:
+//   trig_bench [samples]
+//
+// Точность: sin и cos проверяются на всех 65536 углах, atan2 - на сетке векторов [-1024, 1024]^2
+// против std::sin / std::atan2 в double. Выводятся наибольшая и средняя ошибки
+// (sin, cos - в единицах Q14 и в 1.0, atan2 - в двоичных радианах и градусах).
+// Скорость: время вызова на случайных аргументах против std::sinf / std::atan2f и double.
+// Код возврата 1, если ошибка больше допустимой (sin, cos - 2 единицы Q14, atan2 - 0.02°).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <kf/gfx/Trig.hpp>
+
+using namespace kf;
+using namespace kf::gfx;
+
+static constexpr double pi = 3.14159265358979323846;
+
+/// Допустимая ошибка sin и cos, единиц Q14
+static constexpr double max_sine_error = 2.0;
+
+/// Допустимая ошибка atan2, градусов
+static constexpr double max_angle_error = 0.02;
+
+static double toRadians(trig::Angle angle) { return angle * 2 * pi / 65536; }
+
+/// Разность углов в двоичных радианах с учётом перехода через 0
+static double angleDifference(double a, double b) {
+    double d = std::fmod(a - b, 65536.0);
+    if (d > 32768) { d -= 65536; }
+    if (d < -32768) { d += 65536; }
+    return std::fabs(d);
+}
+
+/// Время вызова, нс (минимум из нескольких прогонов)
+template<typename T, typename F> static double measure(const std::vector<T> &arguments, F call) {
+    volatile double sink = 0;
+    double best = 1e30;
+
+    for (int repeat = 0; repeat < 7; ++repeat) {
+        double sum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto &argument: arguments) { sum += call(argument); }
+        const auto end = std::chrono::steady_clock::now();
+        sink = sink + sum;
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+    }
+
+    return best / static_cast<double>(arguments.size());
+}
+
+struct Vector {
+    i32 x, y;
+};
+
+int main(int argc, char **argv) {
+    const usize samples = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1 << 16;
+
+    // Точность sin и cos на всех углах
+    double sine_max = 0, sine_sum = 0, cosine_max = 0, cosine_sum = 0;
+    for (u32 a = 0; a < 65536; ++a) {
+        const auto angle = static_cast<trig::Angle>(a);
+        const double sine_error = std::fabs(trig::sin(angle) - std::sin(toRadians(angle)) * trig::one);
+        const double cosine_error = std::fabs(trig::cos(angle) - std::cos(toRadians(angle)) * trig::one);
+        sine_max = std::max(sine_max, sine_error);
+        cosine_max = std::max(cosine_max, cosine_error);
+        sine_sum += sine_error;
+        cosine_sum += cosine_error;
+    }
+
+    // Точность atan2 на сетке
+    double angle_max = 0, angle_sum = 0;
+    usize vectors = 0;
+    for (i32 y = -1024; y <= 1024; y += 3) {
+        for (i32 x = -1024; x <= 1024; x += 3) {
+            if (x == 0 and y == 0) { continue; }
+
+            double expected = std::atan2(y, x) / (2 * pi) * 65536;
+            if (expected < 0) { expected += 65536; }
+            const double error = angleDifference(trig::atan2(y, x), expected);
+            angle_max = std::max(angle_max, error);
+            angle_sum += error;
+            vectors += 1;
+        }
+    }
+
+    std::printf("accuracy\n");
+    std::printf("  sin    max %.2f Q14 (%.6f), mean %.3f Q14\n", sine_max, sine_max / trig::one, sine_sum / 65536);
+    std::printf("  cos    max %.2f Q14 (%.6f), mean %.3f Q14\n", cosine_max, cosine_max / trig::one, cosine_sum / 65536);
+    std::printf("  atan2  max %.2f brad (%.4f deg), mean %.3f brad, %zu vectors\n\n",
+                angle_max, angle_max * 360 / 65536, angle_sum / vectors, vectors);
+
+    // Скорость на случайных аргументах
+    std::mt19937 rng{1};
+    std::vector<trig::Angle> angles(samples);
+    std::vector<float> radians_float(samples);
+    std::vector<double> radians_double(samples);
+    std::vector<Vector> points(samples);
+    for (usize i = 0; i < samples; ++i) {
+        angles[i] = static_cast<trig::Angle>(rng());
+        radians_float[i] = static_cast<float>(toRadians(angles[i]));
+        radians_double[i] = toRadians(angles[i]);
+        points[i] = {static_cast<i32>(rng() % 2049) - 1024, static_cast<i32>(rng() % 2049) - 1024};
+    }
+
+    const double sin_ns = measure(angles, [](trig::Angle a) { return trig::sin(a); });
+    const double sinf_ns = measure(radians_float, [](float a) { return std::sin(a); });
+    const double sind_ns = measure(radians_double, [](double a) { return std::sin(a); });
+
+    const double atan2_ns = measure(points, [](const Vector &p) { return trig::atan2(p.y, p.x); });
+    const double atan2f_ns = measure(points, [](const Vector &p) { return std::atan2(static_cast<float>(p.y), static_cast<float>(p.x)); });
+    const double atan2d_ns = measure(points, [](const Vector &p) { return std::atan2(static_cast<double>(p.y), static_cast<double>(p.x)); });
+
+    const double rotation_ns = measure(angles, [](trig::Angle a) {
+        const trig::Rotation rotation{a};
+        return rotation.x(100, 50) + rotation.y(100, 50);
+    });
+    const double rotationf_ns = measure(radians_float, [](float a) {
+        const float c = std::cos(a), s = std::sin(a);
+        return std::lround(100 * c - 50 * s) + std::lround(100 * s + 50 * c);
+    });
+
+    std::printf("%-10s %10s %10s %10s\n", "ns/call", "trig", "float", "double");
+    std::printf("%-10s %10.2f %10.2f %10.2f\n", "sin", sin_ns, sinf_ns, sind_ns);
+    std::printf("%-10s %10.2f %10.2f %10.2f\n", "atan2", atan2_ns, atan2f_ns, atan2d_ns);
+    std::printf("%-10s %10.2f %10.2f %10s\n", "rotation", rotation_ns, rotationf_ns, "-");
+
+    const bool accurate = sine_max <= max_sine_error and cosine_max <= max_sine_error and angle_max * 360 / 65536 <= max_angle_error;
+    return accurate ? 0 : 1;
+}